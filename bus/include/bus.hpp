@@ -5,6 +5,18 @@
 #include <cstddef>
 #include <string>
 
+#include "scheduler.hpp"
+#include "interrupts.hpp"
+
+class DMA;
+class Timers;
+class GPU;
+class SPU;
+class MDEC;
+class CDROM;
+class SIO;
+class Debugger;
+
 class Bus {
     public:
         Bus();
@@ -24,6 +36,29 @@ class Bus {
         bool loadBIOS(const std::string& path);
         void dumpMemoryRegion(uint32_t address, int range);
 
+        // Peripherals own their state; the bus only routes MMIO accesses to them
+        void connectDMA(DMA* device) { dma = device; }
+        void connectTimers(Timers* device) { timers = device; }
+        void connectGPU(GPU* device) { gpu = device; }
+        void connectSPU(SPU* device) { spu = device; }
+        void connectMDEC(MDEC* device) { mdec = device; }
+        void connectCDROM(CDROM* device) { cdrom = device; }
+        void connectSIO(SIO* device) { sio = device; }
+        void connectDebugger(Debugger* device) { debugger = device; }
+
+        // Backing store of main RAM, for devices that move data in bulk (DMA)
+        uint8_t* getRAM() { return mainRAM.data(); }
+        size_t getRAMSize() const { return mainRAM.size(); }
+
+        // --- Watchpoints ---
+        // Divert CPU accesses to the pages covering [phys, phys + bytes) to the
+        // slow path, which reports them to the debugger
+        void watchPages(uint32_t phys, uint32_t bytes, bool reads, bool writes);
+        void clearWatches();
+
+        Scheduler scheduler;
+        Interrupts interrupts;
+
     private:
         // Page Table constants
         static constexpr size_t PAGE_SIZE = 64 * 1024;  // 64KB pages
@@ -31,6 +66,18 @@ class Bus {
 
         // Initialize to nullptr
         std::array<uint8_t*, PAGE_COUNT> memoryMap = {nullptr};
+        // Fast paths: memoryMap minus the watched pages, which take the slow path
+        std::array<uint8_t*, PAGE_COUNT> readMap = {nullptr};
+        std::array<uint8_t*, PAGE_COUNT> writeMap = {nullptr};
+
+        enum PageFlag : uint8_t {
+            PAGE_WATCH_READ = 1 << 0,
+            PAGE_WATCH_WRITE = 1 << 1
+        };
+        std::array<uint8_t, PAGE_COUNT> pageFlags = {0};
+
+        // Set or clear `flag` on the 64KB page of `phys` in every segment mirror
+        void setPageFlag(uint32_t phys, uint8_t flag, bool set);
 
         // --- Mapped to CPU ---
         std::vector<uint8_t> mainRAM;
@@ -41,6 +88,31 @@ class Bus {
         
         void mapRegion(std::vector<uint8_t>& storage, uint32_t startAddr, size_t size);
 
+        // --- MMIO (0x1F801000 - 0x1F801FFF) ---
+        static constexpr uint32_t IO_BASE = 0x1F801000;
+        static constexpr uint32_t IO_END = 0x1F802000;
+
+        // Strips the KSEG0/KSEG1 segment bits
+        static constexpr uint32_t physical(uint32_t address) { return address & 0x1FFFFFFF; }
+        static constexpr bool isIO(uint32_t phys) { return phys >= IO_BASE && phys < IO_END; }
+
+        // The CD-ROM controller sits on an 8-bit bus with FIFO registers, so every
+        // byte lane is a separate access
+        static constexpr bool isCDROM(uint32_t phys) { return phys >= 0x1F801800 && phys < 0x1F801804; }
+
+        // Device registers are word-sized; narrower accesses are shifted into place
+        uint32_t readIO(uint32_t phys);
+        void writeIO(uint32_t phys, uint32_t data, uint32_t size);
+
+        DMA* dma = nullptr;
+        Timers* timers = nullptr;
+        GPU* gpu = nullptr;
+        SPU* spu = nullptr;
+        MDEC* mdec = nullptr;
+        CDROM* cdrom = nullptr;
+        SIO* sio = nullptr;
+        Debugger* debugger = nullptr;
+
         // Internal variables
         uint32_t page_index, offset;
 };
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*
+    Description: Interrupt Controller (I_STAT / I_MASK) Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+enum class IRQ : uint32_t {
+    VBlank  = 0,
+    GPU     = 1,
+    CDROM   = 2,
+    DMA     = 3,
+    Timer0  = 4,
+    Timer1  = 5,
+    Timer2  = 6,
+    SIO0    = 7,
+    SIO     = 8,
+    SPU     = 9,
+    Lightpen = 10,
+};
+
+// I_STAT is atomic because devices running on their own threads (the GPU render
+// thread) may raise interrupts; everything else is emulation-thread only.
+class Interrupts {
+    public:
+        void init() { stat.store(0, std::memory_order_relaxed); mask = 0; }
+
+        void request(IRQ irq) { stat.fetch_or(1u << static_cast<uint32_t>(irq), std::memory_order_relaxed); }
+
+        // I_STAT bits are acknowledged by writing 0 to them
+        void acknowledge(uint32_t value) { stat.fetch_and(value & 0x7FF, std::memory_order_relaxed); }
+        void setMask(uint32_t value) { mask = value & 0x7FF; }
+
+        uint32_t getStat() const { return stat.load(std::memory_order_relaxed); }
+        uint32_t getMask() const { return mask; }
+
+        // State of the line wired to COP0 Cause.IP2
+        bool pending() const { return (getStat() & mask) != 0; }
+
+    private:
+        std::atomic<uint32_t> stat{0};
+        uint32_t mask = 0;
+};
@@ -1,4 +1,13 @@
 #include "bus.hpp"
+#include "dma.hpp"
+#include "timers.hpp"
+#include "gpu.hpp"
+#include "spu.hpp"
+#include "mdec.hpp"
+#include "cdrom.hpp"
+#include "sio.hpp"
+#include "debugger.hpp"
+#include "log.hpp"
 #include <iostream>
 #include <cstring>
 #include <fstream>
@@ -67,6 +76,9 @@ void Bus::init() {
 
     memoryMap.fill(nullptr);
 
+    scheduler.init();
+    interrupts.init();
+
     // Map Physical RAM (KUSEG: 0x00000000)
     mapRegion(mainRAM, 0x00000000, mainRAM.size());
 
@@ -80,18 +92,58 @@ void Bus::init() {
     mapRegion(biosROM, 0x1fc00000, biosROM.size());
     mapRegion(biosROM, 0x9fc00000, biosROM.size());
     mapRegion(biosROM, 0xbfc00000, biosROM.size());    
+
+    readMap = memoryMap;
+    writeMap = memoryMap;
+    pageFlags.fill(0);
+}
+
+void Bus::setPageFlag(uint32_t phys, uint8_t flag, bool set) {
+    const uint32_t base = physical(phys) >> 16;
+    for (uint32_t page : {base, base | 0x8000, base | 0xA000}) {   // KUSEG, KSEG0, KSEG1
+        if (set) pageFlags[page] |= flag;
+        else pageFlags[page] &= ~flag;
+
+        readMap[page] = (pageFlags[page] & PAGE_WATCH_READ) ? nullptr : memoryMap[page];
+        writeMap[page] = (pageFlags[page] & PAGE_WATCH_WRITE) ? nullptr : memoryMap[page];
+    }
+}
+
+void Bus::watchPages(uint32_t phys, uint32_t bytes, bool reads, bool writes) {
+    if (bytes == 0) return;
+    for (uint32_t page = physical(phys) >> 16; page <= (physical(phys) + bytes - 1) >> 16; page++) {
+        if (reads) setPageFlag(page << 16, PAGE_WATCH_READ, true);
+        if (writes) setPageFlag(page << 16, PAGE_WATCH_WRITE, true);
+    }
+}
+
+void Bus::clearWatches() {
+    for (uint32_t page = 0; page < PAGE_COUNT; page++) {
+        if (pageFlags[page] & (PAGE_WATCH_READ | PAGE_WATCH_WRITE)) {
+            setPageFlag(page << 16, PAGE_WATCH_READ | PAGE_WATCH_WRITE, false);
+        }
+    }
 }
 
 uint8_t Bus::read(uint32_t address) {
     page_index = address >> 16;
     offset = address & 0xFFFF;
     
-    if (uint8_t* page = memoryMap[page_index]) {
+    if (uint8_t* page = readMap[page_index]) {
         return page[offset];
     }
+
+    // Watched page
+    if (uint8_t* page = memoryMap[page_index]) {
+        const uint8_t value = page[offset];
+        if (debugger) debugger->onRead(physical(address), 1, value);
+        return value;
+    }
     
-    if (address >= 0x1F801000 && address < 0x1F802000) {
-        return io_ports[address & 0xFFF]; 
+    uint32_t phys = physical(address);
+    if (isIO(phys)) {
+        if (cdrom && isCDROM(phys)) return cdrom->read8(phys & 3);
+        return readIO(phys & ~3u) >> ((phys & 3) * 8);
     }
 
     // Open bus behavior or garbage
@@ -103,11 +155,30 @@ uint32_t Bus::read16(uint32_t address) {
     offset = address & 0xFFFF;
 
     // Fast path: aligned access within a valid page
-    if (uint8_t* page = memoryMap[page_index]) {
+    if (uint8_t* page = readMap[page_index]) {
         // Warning: This assumes host is Little Endian (like PSX)
         return *reinterpret_cast<uint16_t*>(&page[offset]);
     }
 
+    // Watched page
+    if (uint8_t* page = memoryMap[page_index]) {
+        const uint16_t value = *reinterpret_cast<uint16_t*>(&page[offset]);
+        if (debugger) debugger->onRead(physical(address), 2, value);
+        return value;
+    }
+
+    uint32_t phys = physical(address);
+    if (isIO(phys)) {
+        // 16-bit reads of the data FIFO return two consecutive bytes. Each read
+        // pops a FIFO, so the two are sequenced rather than left to operand order.
+        if (cdrom && isCDROM(phys)) {
+            const uint8_t lo = cdrom->read8(phys & 3);
+            const uint8_t hi = cdrom->read8(phys & 3);
+            return lo | (hi << 8);
+        }
+        return (readIO(phys & ~3u) >> ((phys & 2) * 8)) & 0xFFFF;
+    }
+
     // Fallback path
     return (uint16_t)read(address) | ((uint16_t)read(address + 1) << 8);
 }
@@ -117,11 +188,23 @@ uint32_t Bus::read32(uint32_t address) {
     offset = address & 0xFFFF;
 
     // Fast path: aligned access within a valid page
-    if (uint8_t* page = memoryMap[page_index]) {
+    if (uint8_t* page = readMap[page_index]) {
         // Warning: This assumes host is Little Endian (like PSX)
         return *reinterpret_cast<uint32_t*>(&page[offset]);
     }
 
+    // Watched page
+    if (uint8_t* page = memoryMap[page_index]) {
+        const uint32_t value = *reinterpret_cast<uint32_t*>(&page[offset]);
+        if (debugger) debugger->onRead(physical(address), 4, value);
+        return value;
+    }
+
+    uint32_t phys = physical(address);
+    if (isIO(phys)) {
+        return readIO(phys);
+    }
+
     // Fallback path
     return (uint32_t)read(address) | ((uint32_t)read(address + 1) << 8) | ((uint32_t)read(address + 2) << 16) | ((uint32_t)read(address + 3) << 24);
 }
@@ -130,14 +213,22 @@ void Bus::write(uint32_t address, uint8_t data) {
     page_index = address >> 16;
     offset = address & 0xFFFF;
 
+    if (uint8_t* page = writeMap[page_index]) {
+        page[offset] = data;
+        return;
+    }
+
+    // Watched page
     if (uint8_t* page = memoryMap[page_index]) {
         page[offset] = data;
+        if (debugger) debugger->onWrite(physical(address), 1, data);
         return;
     }
 
-    if (address >= 0x1F801000 && address < 0x1F802000) {
-         io_ports[address & 0xFFF] = data;
-         return;
+    uint32_t phys = physical(address);
+    if (isIO(phys)) {
+        writeIO(phys, data, 1);
+        return;
     }
 }
 
@@ -145,8 +236,21 @@ void Bus::write16(uint32_t address, uint16_t data) {
     page_index = address >> 16;
     offset = address & 0xFFFF;
 
+    if (uint8_t* page = writeMap[page_index]) {
+        *reinterpret_cast<uint16_t*>(&page[offset]) = data;
+        return;
+    }
+
+    // Watched page
     if (uint8_t* page = memoryMap[page_index]) {
         *reinterpret_cast<uint16_t*>(&page[offset]) = data;
+        if (debugger) debugger->onWrite(physical(address), 2, data);
+        return;
+    }
+
+    uint32_t phys = physical(address);
+    if (isIO(phys)) {
+        writeIO(phys, data, 2);
         return;
     }
     
@@ -159,8 +263,21 @@ void Bus::write32(uint32_t address, uint32_t data) {
     page_index = address >> 16;
     offset = address & 0xFFFF;
 
+    if (uint8_t* page = writeMap[page_index]) {
+        *reinterpret_cast<uint32_t*>(&page[offset]) = data;
+        return;
+    }
+
+    // Watched page
     if (uint8_t* page = memoryMap[page_index]) {
         *reinterpret_cast<uint32_t*>(&page[offset]) = data;
+        if (debugger) debugger->onWrite(physical(address), 4, data);
+        return;
+    }
+
+    uint32_t phys = physical(address);
+    if (isIO(phys)) {
+        writeIO(phys, data, 4);
         return;
     }
     
@@ -169,4 +286,134 @@ void Bus::write32(uint32_t address, uint32_t data) {
     write(address + 1, (data >> 8) & 0xFF);
     write(address + 2, (data >> 16) & 0xFF);
     write(address + 3, (data >> 24) & 0xFF);
-}
\ No newline at end of file
+}
+
+uint32_t Bus::readIO(uint32_t phys) {
+    // Interrupt controller
+    if (phys >= 0x1F801070 && phys < 0x1F801078) {
+        return (phys & 4) ? interrupts.getMask() : interrupts.getStat();
+    }
+
+    // SIO0 (controllers, memory cards): halfword registers
+    if (sio && phys >= 0x1F801040 && phys < 0x1F801050) {
+        return sio->read16(phys & 0xC) | (static_cast<uint32_t>(sio->read16((phys & 0xC) | 2)) << 16);
+    }
+
+    // DMA controller
+    if (dma && phys >= 0x1F801080 && phys < 0x1F801100) {
+        return dma->read32(phys & 0x7C);
+    }
+
+    // Root counters
+    if (timers && phys >= 0x1F801100 && phys < 0x1F801130) {
+        return timers->read32(phys & 0x3C);
+    }
+
+    // GPU: GPUREAD / GPUSTAT
+    if (gpu && phys >= 0x1F801810 && phys < 0x1F801818) {
+        return gpu->read32(phys & 0x4);
+    }
+
+    // MDEC: data / status
+    if (mdec && phys >= 0x1F801820 && phys < 0x1F801828) {
+        return mdec->read32(phys & 0x4);
+    }
+
+    // CD-ROM: a word read is four byte reads, in address order
+    if (cdrom && isCDROM(phys)) {
+        const uint8_t b0 = cdrom->read8(0);
+        const uint8_t b1 = cdrom->read8(1);
+        const uint8_t b2 = cdrom->read8(2);
+        const uint8_t b3 = cdrom->read8(3);
+        return b0 | (b1 << 8) | (b2 << 16) | (static_cast<uint32_t>(b3) << 24);
+    }
+
+    // SPU: halfword registers, a word read covers two of them
+    if (spu && phys >= 0x1F801C00 && phys < 0x1F802000) {
+        return spu->read16(phys & 0x3FC) | (static_cast<uint32_t>(spu->read16((phys & 0x3FC) | 2)) << 16);
+    }
+
+    // Unhandled ports behave as plain storage for now
+    LOG_DEBUG("Bus", "Unhandled IO read 0x{x}", phys);
+    uint32_t value;
+    std::memcpy(&value, &io_ports[phys & 0xFFC], sizeof(value));
+    return value;
+}
+
+void Bus::writeIO(uint32_t phys, uint32_t data, uint32_t size) {
+    uint32_t shift = (phys & 3) * 8;
+    // Bytes of the word register a byte or halfword store actually replaces
+    const uint32_t lanes = size == 4 ? 0xFFFFFFFF : ((1u << (size * 8)) - 1) << shift;
+
+    if (phys >= 0x1F801070 && phys < 0x1F801078) {
+        // I_STAT bits outside the stored bytes are written as 1, which keeps them
+        if (phys & 4) interrupts.setMask((interrupts.getMask() & ~lanes) | ((data << shift) & lanes));
+        else interrupts.acknowledge((data << shift) | ~lanes);
+        return;
+    }
+
+    if (sio && phys >= 0x1F801040 && phys < 0x1F801050) {
+        if (size == 4) {
+            sio->write16(phys & 0xC, data & 0xFFFF);
+            sio->write16((phys & 0xC) | 2, data >> 16);
+        } else {
+            sio->write16(phys & 0xE, data & 0xFFFF);
+        }
+        return;
+    }
+
+    if (dma && phys >= 0x1F801080 && phys < 0x1F801100) {
+        uint32_t current = dma->read32(phys & 0x7C);
+        // DICR flags are acknowledged by writing 1: never write back the ones read
+        if ((phys & 0x7C) == 0x74) current &= 0x00FFFFFF;
+        dma->write32(phys & 0x7C, (current & ~lanes) | ((data << shift) & lanes));
+        return;
+    }
+
+    if (timers && phys >= 0x1F801100 && phys < 0x1F801130) {
+        uint32_t current = timers->peek32(phys & 0x3C);
+        timers->write32(phys & 0x3C, (current & ~lanes) | ((data << shift) & lanes));
+        return;
+    }
+
+    // GP0/GP1 and the MDEC ports are command FIFOs and write-only control
+    // registers; reading them back returns other registers, so there is no
+    // value to merge a byte or halfword into
+    if (gpu && phys >= 0x1F801810 && phys < 0x1F801818) {
+        if (size != 4) {
+            LOG_DEBUG("Bus", "Ignored {}-byte GPU write 0x{x} = 0x{x}", size, phys, data);
+            return;
+        }
+        gpu->write32(phys & 0x4, data);
+        return;
+    }
+
+    if (mdec && phys >= 0x1F801820 && phys < 0x1F801828) {
+        if (size != 4) {
+            LOG_DEBUG("Bus", "Ignored {}-byte MDEC write 0x{x} = 0x{x}", size, phys, data);
+            return;
+        }
+        mdec->write32(phys & 0x4, data);
+        return;
+    }
+
+    if (cdrom && isCDROM(phys)) {
+        for (uint32_t i = 0; i < size; i++) {
+            cdrom->write8((phys + i) & 3, (data >> (i * 8)) & 0xFF);
+        }
+        return;
+    }
+
+    if (spu && phys >= 0x1F801C00 && phys < 0x1F802000) {
+        if (size == 4) {
+            spu->write16(phys & 0x3FC, data & 0xFFFF);
+            spu->write16((phys & 0x3FC) | 2, data >> 16);
+        } else {
+            spu->write16(phys & 0x3FE, data & 0xFFFF);
+        }
+        return;
+    }
+
+    LOG_DEBUG("Bus", "Unhandled IO write 0x{x} = 0x{x} ({} bytes)", phys, data, size);
+    std::memcpy(&io_ports[phys & 0xFFF], &data, size);
+}
@@ -0,0 +1,30 @@
+/*
+    Description: Memory-Mapped BIN Sector Source Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include "disc_image.hpp"
+#include "mapped_file.hpp"
+
+// Uncompressed raw image. Sector reads are pointers straight into the mapping;
+// read-ahead is a madvise() hint so the kernel pages the run in asynchronously.
+class BinSource : public SectorSource {
+    public:
+        bool open(const std::string& path);
+
+        uint32_t sectors() const override { return sector_count; }
+        // Never copies: the mapping lives as long as the source
+        const uint8_t* read(uint32_t index, uint8_t* scratch) override;
+        void prefetch(uint32_t index, uint32_t count) override;
+
+    private:
+        MappedFile file;
+        uint32_t sector_count = 0;
+
+        // End of the range already handed to the kernel, and the run length to keep ahead
+        uint32_t advised_end = 0;
+        uint32_t ahead = 0;
+};
@@ -0,0 +1,152 @@
+/*
+    Description: CD-ROM Controller Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <memory>
+
+#include "disc_image.hpp"
+#include "dma.hpp"
+
+class Bus;
+
+// The controller answers every command at write time: its responses are queued
+// with the cycle they become visible and handed out by a scheduler event, one at
+// a time, as the CPU acknowledges the previous interrupt. The drive itself is a
+// second event that fires once per sector period (or when a seek lands), so the
+// CPU never polls and sectors arrive at the real 75/150 Hz rate. BIN sectors are
+// read in place from the mapping; sources that recycle their storage (ECM) copy
+// each sector once, into one of two controller buffers, so the drive can read
+// into one while the data FIFO drains the other.
+class CDROM {
+    public:
+        CDROM(Bus* bus);
+        ~CDROM();
+
+        void init();
+
+        // nullptr ejects the current disc
+        void insertDisc(std::unique_ptr<DiscImage> image);
+
+        // Register interface (offset relative to 0x1F801800, byte registers)
+        uint8_t read8(uint32_t offset);
+        void write8(uint32_t offset, uint8_t data);
+
+        // DMA channel 3 endpoint
+        DMAPort dmaPort();
+
+    private:
+        static constexpr uint32_t FIFO_SIZE = 16;
+
+        // Status byte
+        static constexpr uint8_t STAT_ERROR = 1 << 0;
+        static constexpr uint8_t STAT_MOTOR = 1 << 1;
+        static constexpr uint8_t STAT_ID_ERROR = 1 << 3;
+        static constexpr uint8_t STAT_SHELL_OPEN = 1 << 4;
+        static constexpr uint8_t STAT_READING = 1 << 5;
+        static constexpr uint8_t STAT_SEEKING = 1 << 6;
+        static constexpr uint8_t STAT_PLAYING = 1 << 7;
+
+        // Setmode bits
+        static constexpr uint8_t MODE_AUTOPAUSE = 1 << 1;
+        static constexpr uint8_t MODE_WHOLE_SECTOR = 1 << 5;
+        static constexpr uint8_t MODE_XA_ADPCM = 1 << 6;
+        static constexpr uint8_t MODE_DOUBLE_SPEED = 1 << 7;
+
+        static constexpr uint32_t NO_SECTOR = UINT32_MAX;
+
+        enum class Drive : uint8_t { Idle, Seeking, Reading, Playing };
+
+        struct Response {
+            uint64_t due;                       // Earliest cycle the interrupt may fire
+            uint8_t irq;                        // INT1-INT5
+            uint8_t size;
+            bool ack;                           // First response of a command (clears busy)
+            uint32_t sector;                    // INT1: LBA that becomes readable
+            std::array<uint8_t, FIFO_SIZE> bytes;
+        };
+
+        static void onResponse(void* ctx, uint64_t now);
+        static void onSector(void* ctx, uint64_t now);
+        static void dmaFromDevice(void* ctx, uint32_t* words, uint32_t count);
+
+        // --- Commands ---
+        void execute(uint8_t cmd);
+        void queue(uint64_t delay, uint8_t irq, const uint8_t* bytes, uint32_t size, bool ack = false);
+        void queue(uint64_t delay, uint8_t irq, std::initializer_list<uint8_t> bytes, bool ack = false) {
+            queue(delay, irq, bytes.begin(), static_cast<uint32_t>(bytes.size()), ack);
+        }
+        void queueSector(uint32_t lba);
+        void insert(const Response& r);
+        void acknowledge(uint64_t delay);
+        void error(uint8_t code);
+        bool needParams(uint32_t count);
+
+        // --- Interrupt delivery ---
+        void deliver(uint64_t now);
+        void scheduleDelivery();
+        void dropSectors();
+
+        // --- Drive ---
+        uint8_t status() const;
+        uint32_t sectorPeriod() const;
+        void startSeek(Drive then, bool report);
+        void stopDrive();
+        void readNextSector();
+        void loadDataFifo();
+        void detectRegion();
+
+        Bus* bus = nullptr;
+        std::unique_ptr<DiscImage> disc;
+
+        // Host interface
+        uint8_t index = 0;
+        uint8_t irq_enable = 0;
+        uint8_t irq_flag = 0;
+        bool busy = false;
+
+        std::array<uint8_t, FIFO_SIZE> params;
+        uint32_t param_count = 0;
+
+        std::array<uint8_t, FIFO_SIZE> response;
+        uint32_t response_size = 0;
+        uint32_t response_pos = 0;
+
+        // Scratch for copying sources; the FIFO never points into buffers[drive_buffer]
+        std::array<std::array<uint8_t, SectorSource::SECTOR_SIZE>, 2> buffers;
+        uint32_t drive_buffer = 0;
+
+        // Last sector the drive read, reused by BFRD when it is the one delivered
+        const uint8_t* drive_sector = nullptr;
+        uint32_t drive_lba = NO_SECTOR;
+
+        // Data FIFO: a window into the last sector loaded with BFRD
+        const uint8_t* data = nullptr;
+        uint32_t data_size = 0;
+        uint32_t data_pos = 0;
+        uint32_t loaded_sector = NO_SECTOR;
+
+        std::deque<Response> pending;
+        uint32_t ready_sector = NO_SECTOR;  // LBA of the last delivered INT1
+
+        // Drive state
+        Drive drive = Drive::Idle;
+        Drive after_seek = Drive::Idle;
+        bool seek_report = false;           // SeekL/P answer with INT2 once the head lands
+        bool motor = false;
+        bool shell_opened = false;          // Latched until the next Getstat
+        uint8_t mode = 0;
+        uint8_t filter_file = 0;
+        uint8_t filter_channel = 0;
+        uint32_t seek_target = 0;           // From Setloc
+        uint32_t position = 0;              // Next LBA under the head
+        std::array<uint8_t, 8> last_header; // Header + subheader for GetlocL
+        char region = 'A';
+};
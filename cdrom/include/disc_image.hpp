@@ -0,0 +1,85 @@
+/*
+    Description: CD Image Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Raw sector store behind one FILE of a cue sheet (or a lone image file).
+// Sectors are always 2352 bytes, sync pattern included.
+class SectorSource {
+    public:
+        static constexpr uint32_t SECTOR_SIZE = 2352;
+
+        virtual ~SectorSource() = default;
+
+        virtual uint32_t sectors() const = 0;
+
+        // nullptr past the end of the source. Sources that keep every sector
+        // addressable return a pointer valid for their whole lifetime; sources
+        // that recycle their storage copy the sector into `scratch` (SECTOR_SIZE
+        // bytes) and return it.
+        virtual const uint8_t* read(uint32_t index, uint8_t* scratch) = 0;
+
+        // The drive will stream `count` sectors starting at `index` next
+        virtual void prefetch(uint32_t index, uint32_t count) = 0;
+};
+
+struct Track {
+    uint8_t number;
+    bool audio;
+    uint32_t start;     // Disc LBA of INDEX 01
+    uint32_t length;    // Sectors up to the next track (or the end of the disc)
+};
+
+// A disc laid out from one or more sources. LBA 0 is MSF 00:02:00, the first
+// sector of track 1; pregaps that are not stored in any file read as silence.
+class DiscImage {
+    public:
+        // Open a .cue sheet, a raw 2352-byte .bin, or an .ecm compressed image.
+        // Returns nullptr (after logging why) when the image cannot be used.
+        static std::unique_ptr<DiscImage> open(const std::string& path);
+
+        // Raw sector at `lba`; sectors outside the image read as zeroes.
+        // Either a pointer that lives as long as the image, or `scratch`.
+        const uint8_t* readSector(uint32_t lba, uint8_t* scratch);
+
+        // Start fetching ahead of a seek to `lba` for a drive reading at
+        // `sectors_per_second`, so the data is resident when the head gets there
+        void prefetch(uint32_t lba, uint32_t sectors_per_second);
+
+        const std::vector<Track>& getTracks() const { return tracks; }
+        uint32_t getSectorCount() const { return sector_count; }
+
+        // Track containing `lba` (the last track for LBAs past the end)
+        const Track& trackAt(uint32_t lba) const;
+
+    private:
+        // Contiguous run of disc sectors; a null source is a pregap of silence
+        struct Segment {
+            uint32_t start;
+            uint32_t count;
+            SectorSource* source;
+            uint32_t first;         // Index of the first sector within the source
+        };
+
+        static std::unique_ptr<SectorSource> openSource(const std::string& path);
+        bool parseCue(const std::string& path);
+        bool openSingle(const std::string& path);
+        void finishTracks();
+        const Segment* segmentAt(uint32_t lba) const;
+
+        std::vector<std::unique_ptr<SectorSource>> sources;
+        std::vector<Segment> segments;
+        std::vector<Track> tracks;
+        uint32_t sector_count = 0;
+
+        // Read-ahead length, from the last prefetch() call
+        uint32_t ahead = 0;
+};
@@ -0,0 +1,68 @@
+/*
+    Description: ECM Compressed Sector Source Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "disc_image.hpp"
+#include "mapped_file.hpp"
+
+// ECM image (sync, headers, EDC and ECC stripped out of every sector). The file
+// is mapped and indexed once; sectors are rebuilt into a direct-mapped cache
+// by a background thread that runs ahead of the drive. A read that misses the
+// cache rebuilds its sector on the calling thread.
+class EcmSource : public SectorSource {
+    public:
+        ~EcmSource() override;
+
+        bool open(const std::string& path);
+
+        uint32_t sectors() const override { return sector_count; }
+        // Copies out of the cache under the lock, since the worker recycles slots
+        const uint8_t* read(uint32_t index, uint8_t* scratch) override;
+        void prefetch(uint32_t index, uint32_t count) override;
+
+    private:
+        static constexpr uint32_t CACHE_SECTORS = 1024;
+        static constexpr uint32_t NO_SECTOR = UINT32_MAX;
+
+        // One type/count record of the ECM stream
+        struct Record {
+            uint64_t out_offset;    // Position in the decoded image
+            uint64_t out_bytes;
+            uint64_t in_offset;     // Position of the payload in the .ecm file
+            uint32_t type;          // 0 = literal bytes, 1-3 = stripped sectors
+        };
+
+        struct Slot {
+            uint32_t index = NO_SECTOR;
+            bool busy = false;      // Being rebuilt outside the lock
+            std::array<uint8_t, SECTOR_SIZE> data;
+        };
+
+        bool buildIndex();
+        void decode(uint64_t offset, uint8_t* dst, size_t count) const;
+        void fill(Slot& slot, uint32_t index, std::unique_lock<std::mutex>& lock);
+        void workerLoop();
+
+        MappedFile file;
+        std::vector<Record> records;
+        uint32_t sector_count = 0;
+
+        std::vector<Slot> cache;
+        std::mutex mutex;
+        std::condition_variable wake, filled;
+        uint32_t ahead_next = 0, ahead_end = 0;   // Window the worker is filling
+        uint32_t ahead = 0;
+        bool quit = false;
+        std::thread worker;
+};
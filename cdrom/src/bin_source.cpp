@@ -0,0 +1,35 @@
+/*
+    Description: Memory-Mapped BIN Sector Source Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "bin_source.hpp"
+#include <algorithm>
+
+bool BinSource::open(const std::string& path) {
+    if (!file.open(path)) return false;
+
+    // A trailing partial sector is ignored
+    sector_count = static_cast<uint32_t>(file.size() / SECTOR_SIZE);
+    return sector_count > 0;
+}
+
+const uint8_t* BinSource::read(uint32_t index, uint8_t* scratch) {
+    (void)scratch;
+    if (index >= sector_count) return nullptr;
+
+    // Keep the advised window ahead of a sequential reader
+    if (ahead > 0 && index + ahead / 2 >= advised_end) {
+        prefetch(std::max(index, advised_end), ahead);
+    }
+    return file.data() + static_cast<size_t>(index) * SECTOR_SIZE;
+}
+
+void BinSource::prefetch(uint32_t index, uint32_t count) {
+    ahead = count;
+    advised_end = std::min(index + count, sector_count);
+    if (index < advised_end) {
+        file.willNeed(static_cast<size_t>(index) * SECTOR_SIZE, static_cast<size_t>(advised_end - index) * SECTOR_SIZE);
+    }
+}
@@ -0,0 +1,576 @@
+/*
+    Description: CD-ROM Controller Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "cdrom.hpp"
+#include "bus.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+namespace {
+    constexpr uint32_t CPU_CLOCK = 33868800;
+
+    // One sector at 1x (75 sectors per second); 2x halves it
+    constexpr uint32_t SECTOR_CYCLES = CPU_CLOCK / 75;
+
+    // First response (INT3) of an ordinary command, and of Init
+    constexpr uint64_t ACK_DELAY = 0xC4E1;
+    constexpr uint64_t ACK_DELAY_INIT = 0x13CCE;
+
+    // Second response of GetID / Init / MotorOn / SetSession, after the first
+    constexpr uint64_t SECOND_DELAY = 0x4A00;
+
+    // Pause/Stop while idle; while reading the drive first finishes ~5 sectors
+    constexpr uint64_t PAUSE_IDLE_DELAY = 0x1DF2;
+    constexpr uint32_t PAUSE_READING_SECTORS = 5;
+
+    constexpr uint64_t TOC_DELAY = CPU_CLOCK / 2;
+    constexpr uint64_t SPIN_UP_DELAY = CPU_CLOCK / 2;
+
+    // Seek time grows with the distance travelled
+    constexpr uint64_t SEEK_MIN_DELAY = 20000;
+    constexpr uint64_t SEEK_CYCLES_PER_SECTOR = 10;
+
+    // Error codes of INT5 responses
+    constexpr uint8_t ERR_BAD_PARAM = 0x10;
+    constexpr uint8_t ERR_PARAM_COUNT = 0x20;
+    constexpr uint8_t ERR_BAD_COMMAND = 0x40;
+    constexpr uint8_t ERR_NO_DISC = 0x80;
+
+    constexpr uint8_t toBCD(uint32_t value) { return static_cast<uint8_t>((value / 10) << 4 | (value % 10)); }
+    constexpr uint32_t fromBCD(uint8_t value) { return (value >> 4) * 10 + (value & 0xF); }
+}
+
+CDROM::CDROM(Bus* bus) : bus(bus) {
+    init();
+}
+
+CDROM::~CDROM() = default;
+
+void CDROM::init() {
+    index = 0;
+    irq_enable = 0;
+    irq_flag = 0;
+    busy = false;
+    param_count = 0;
+    response_size = response_pos = 0;
+    data = nullptr;
+    data_size = data_pos = 0;
+    pending.clear();
+    ready_sector = loaded_sector = NO_SECTOR;
+    drive_sector = nullptr;
+    drive_lba = NO_SECTOR;
+
+    drive = Drive::Idle;
+    motor = false;
+    mode = 0;
+    filter_file = filter_channel = 0;
+    seek_target = position = 0;
+    last_header.fill(0);
+
+    bus->scheduler.registerEvent(Event::CDROM, &CDROM::onResponse, this);
+    bus->scheduler.registerEvent(Event::CDROMSector, &CDROM::onSector, this);
+}
+
+void CDROM::insertDisc(std::unique_ptr<DiscImage> image) {
+    stopDrive();
+    disc = std::move(image);
+    shell_opened = true;
+    position = seek_target = 0;
+    ready_sector = loaded_sector = NO_SECTOR;
+    drive_sector = nullptr;
+    drive_lba = NO_SECTOR;
+    data = nullptr;
+    data_size = data_pos = 0;
+
+    if (disc) detectRegion();
+}
+
+// The licence text in the system area names the region the disc was pressed for
+void CDROM::detectRegion() {
+    const uint8_t* sector = disc->readSector(4, buffers[drive_buffer].data());
+    const std::string_view licence(reinterpret_cast<const char*>(sector + 24), 0x800);
+
+    if (licence.find("Europe") != std::string_view::npos) region = 'E';
+    else if (licence.find("Amer") != std::string_view::npos) region = 'A';
+    else if (licence.find("Inc.") != std::string_view::npos) region = 'I';
+    else region = 'A';
+}
+
+DMAPort CDROM::dmaPort() {
+    DMAPort port;
+    port.ctx = this;
+    port.fromDevice = &CDROM::dmaFromDevice;
+    return port;
+}
+
+void CDROM::dmaFromDevice(void* ctx, uint32_t* words, uint32_t count) {
+    CDROM* cd = static_cast<CDROM*>(ctx);
+    const uint32_t bytes = count * 4;
+    const uint32_t run = std::min(bytes, cd->data_size - cd->data_pos);
+
+    uint8_t* dst = reinterpret_cast<uint8_t*>(words);
+    std::memcpy(dst, cd->data + cd->data_pos, run);
+    cd->data_pos += run;
+
+    // Reading past the end of the sector yields nothing useful
+    std::memset(dst + run, 0, bytes - run);
+}
+
+uint8_t CDROM::read8(uint32_t offset) {
+    switch (offset) {
+        case 0:
+            return index
+                 | (param_count == 0) << 3
+                 | (param_count < FIFO_SIZE) << 4
+                 | (response_pos < response_size) << 5
+                 | (data_pos < data_size) << 6
+                 | busy << 7;
+        case 1:
+            return response_pos < response_size ? response[response_pos++] : 0;
+        case 2:
+            return data_pos < data_size ? data[data_pos++] : 0;
+        default:
+            return ((index & 1) ? irq_flag : irq_enable) | 0xE0;
+    }
+}
+
+void CDROM::write8(uint32_t offset, uint8_t value) {
+    switch (offset << 2 | index) {
+        case 0x0: case 0x1: case 0x2: case 0x3:
+            index = value & 3;
+            break;
+
+        // Command
+        case 0x4:
+            busy = true;
+            execute(value);
+            param_count = 0;
+            break;
+
+        // Parameter FIFO
+        case 0x8:
+            if (param_count < FIFO_SIZE) params[param_count++] = value;
+            break;
+
+        case 0x9:
+            irq_enable = value & 0x1F;
+            if (irq_flag & irq_enable) bus->interrupts.request(IRQ::CDROM);
+            break;
+
+        // Request register: BFRD loads the data FIFO with the last delivered sector
+        case 0xC:
+            if (value & 0x80) {
+                if (loaded_sector != ready_sector || data_pos >= data_size) loadDataFifo();
+            } else {
+                data = nullptr;
+                data_size = data_pos = 0;
+            }
+            break;
+
+        // Interrupt acknowledge
+        case 0xD:
+            irq_flag &= ~(value & 0x1F);
+            if (value & 0x40) param_count = 0;
+            if (irq_flag == 0) scheduleDelivery();
+            break;
+
+        // Audio volume / XA-ADPCM control: CD audio is not mixed yet
+        default:
+            break;
+    }
+}
+
+void CDROM::loadDataFifo() {
+    data = nullptr;
+    data_size = data_pos = 0;
+    loaded_sector = ready_sector;
+    if (!disc || ready_sector == NO_SECTOR) return;
+
+    const uint8_t* sector;
+    if (ready_sector == drive_lba) {
+        sector = drive_sector;
+        // The FIFO takes over the drive's buffer; the drive reads into the other one
+        if (sector == buffers[drive_buffer].data()) drive_buffer ^= 1;
+    } else {
+        // The drive has moved past the delivered sector
+        sector = disc->readSector(ready_sector, buffers[drive_buffer ^ 1].data());
+    }
+
+    if (mode & MODE_WHOLE_SECTOR) {
+        data = sector + 12;
+        data_size = 0x924;
+    } else {
+        data = sector + 24;
+        data_size = 0x800;
+    }
+}
+
+// --- Commands ---
+
+void CDROM::queue(uint64_t delay, uint8_t irq, const uint8_t* bytes, uint32_t size, bool ack) {
+    Response r;
+    r.due = bus->scheduler.timestamp() + delay;
+    r.irq = irq;
+    r.size = static_cast<uint8_t>(size);
+    r.ack = ack;
+    r.sector = NO_SECTOR;
+    std::copy(bytes, bytes + size, r.bytes.begin());
+    insert(r);
+}
+
+// Keeps the queue ordered by due time; equal times stay in issue order
+void CDROM::insert(const Response& r) {
+    auto it = std::find_if(pending.begin(), pending.end(), [&](const Response& p) { return p.due > r.due; });
+    pending.insert(it, r);
+    scheduleDelivery();
+}
+
+void CDROM::acknowledge(uint64_t delay) {
+    queue(delay, 3, {status()}, true);
+}
+
+void CDROM::error(uint8_t code) {
+    queue(ACK_DELAY, 5, {static_cast<uint8_t>(status() | STAT_ERROR), code}, true);
+}
+
+bool CDROM::needParams(uint32_t count) {
+    if (param_count == count) return true;
+    error(ERR_PARAM_COUNT);
+    return false;
+}
+
+void CDROM::execute(uint8_t cmd) {
+    switch (cmd) {
+        // Getstat
+        case 0x01:
+            acknowledge(ACK_DELAY);
+            if (disc) shell_opened = false;
+            break;
+
+        // Setloc
+        case 0x02: {
+            if (!needParams(3)) break;
+            const uint32_t msf = (fromBCD(params[0]) * 60 + fromBCD(params[1])) * 75 + fromBCD(params[2]);
+            seek_target = msf >= 150 ? msf - 150 : 0;
+            acknowledge(ACK_DELAY);
+
+            // Known seconds before the read command: start fetching now
+            if (disc) disc->prefetch(seek_target, (mode & MODE_DOUBLE_SPEED) ? 150 : 75);
+            break;
+        }
+
+        // Play
+        case 0x03:
+            if (!disc) { error(ERR_NO_DISC); break; }
+            if (param_count > 0 && params[0] != 0) {
+                const uint32_t track = fromBCD(params[0]);
+                const auto& tracks = disc->getTracks();
+                if (track <= tracks.size()) seek_target = tracks[track - 1].start;
+            }
+            acknowledge(ACK_DELAY);
+            startSeek(Drive::Playing, false);
+            break;
+
+        // Forward / Backward
+        case 0x04: case 0x05:
+            acknowledge(ACK_DELAY);
+            break;
+
+        // ReadN / ReadS
+        case 0x06: case 0x1B:
+            if (!disc) { error(ERR_NO_DISC); break; }
+            acknowledge(ACK_DELAY);
+            startSeek(Drive::Reading, false);
+            break;
+
+        // MotorOn
+        case 0x07:
+            motor = true;
+            acknowledge(ACK_DELAY);
+            queue(ACK_DELAY + SECOND_DELAY, 2, {status()});
+            break;
+
+        // Stop / Pause
+        case 0x08: case 0x09: {
+            const bool was_busy = drive != Drive::Idle;
+            acknowledge(ACK_DELAY);
+            stopDrive();
+            if (cmd == 0x08) motor = false;
+            const uint64_t delay = was_busy ? uint64_t(sectorPeriod()) * PAUSE_READING_SECTORS : PAUSE_IDLE_DELAY;
+            queue(ACK_DELAY + delay, 2, {status()});
+            break;
+        }
+
+        // Init
+        case 0x0A:
+            stopDrive();
+            mode = 0;
+            motor = true;
+            acknowledge(ACK_DELAY_INIT);
+            queue(ACK_DELAY_INIT + SECOND_DELAY, 2, {status()});
+            break;
+
+        // Mute / Demute
+        case 0x0B: case 0x0C:
+            acknowledge(ACK_DELAY);
+            break;
+
+        // Setfilter
+        case 0x0D:
+            if (!needParams(2)) break;
+            filter_file = params[0];
+            filter_channel = params[1];
+            acknowledge(ACK_DELAY);
+            break;
+
+        // Setmode
+        case 0x0E:
+            if (!needParams(1)) break;
+            mode = params[0];
+            acknowledge(ACK_DELAY);
+            break;
+
+        // Getparam
+        case 0x0F:
+            queue(ACK_DELAY, 3, {status(), mode, 0, filter_file, filter_channel}, true);
+            break;
+
+        // GetlocL: header and subheader of the last sector read
+        case 0x10:
+            queue(ACK_DELAY, 3, last_header.data(), static_cast<uint32_t>(last_header.size()), true);
+            break;
+
+        // GetlocP
+        case 0x11: {
+            if (!disc) { error(ERR_NO_DISC); break; }
+            const Track& track = disc->trackAt(position);
+            const uint32_t rel = position >= track.start ? position - track.start : track.start - position;
+            const uint32_t abs = position + 150;
+            queue(ACK_DELAY, 3, {toBCD(track.number), 1,
+                                 toBCD(rel / 4500), toBCD(rel / 75 % 60), toBCD(rel % 75),
+                                 toBCD(abs / 4500), toBCD(abs / 75 % 60), toBCD(abs % 75)}, true);
+            break;
+        }
+
+        // SetSession: single-session images only
+        case 0x12:
+            if (!needParams(1)) break;
+            if (params[0] != 1) { error(ERR_BAD_PARAM); break; }
+            acknowledge(ACK_DELAY);
+            queue(ACK_DELAY + SECOND_DELAY, 2, {status()});
+            break;
+
+        // GetTN
+        case 0x13:
+            if (!disc) { error(ERR_NO_DISC); break; }
+            queue(ACK_DELAY, 3, {status(), 1, toBCD(static_cast<uint32_t>(disc->getTracks().size()))}, true);
+            break;
+
+        // GetTD: track 0 is the end of the disc
+        case 0x14: {
+            if (!needParams(1)) break;
+            if (!disc) { error(ERR_NO_DISC); break; }
+            const uint32_t track = fromBCD(params[0]);
+            const auto& tracks = disc->getTracks();
+            if (track > tracks.size()) { error(ERR_BAD_PARAM); break; }
+            const uint32_t lba = (track == 0 ? disc->getSectorCount() : tracks[track - 1].start) + 150;
+            queue(ACK_DELAY, 3, {status(), toBCD(lba / 4500), toBCD(lba / 75 % 60)}, true);
+            break;
+        }
+
+        // SeekL / SeekP
+        case 0x15: case 0x16:
+            if (!disc) { error(ERR_NO_DISC); break; }
+            acknowledge(ACK_DELAY);
+            startSeek(Drive::Idle, true);
+            break;
+
+        // Test: only the BIOS version query is answered
+        case 0x19:
+            if (param_count == 0) { error(ERR_PARAM_COUNT); break; }
+            if (params[0] != 0x20) { error(ERR_BAD_PARAM); break; }
+            queue(ACK_DELAY, 3, {0x94, 0x09, 0x19, 0xC0}, true);
+            break;
+
+        // GetID
+        case 0x1A:
+            acknowledge(ACK_DELAY);
+            if (!disc) {
+                queue(ACK_DELAY + SECOND_DELAY, 5, {0x08, 0x40, 0, 0, 0, 0, 0, 0});
+            } else if (disc->getTracks().front().audio) {
+                queue(ACK_DELAY + SECOND_DELAY, 5, {0x0A, 0x90, 0, 0, 0, 0, 0, 0});
+            } else {
+                queue(ACK_DELAY + SECOND_DELAY, 2, {0x02, 0x00, 0x20, 0x00, 'S', 'C', 'E', static_cast<uint8_t>(region)});
+            }
+            break;
+
+        // Reset
+        case 0x1C:
+            stopDrive();
+            mode = 0;
+            acknowledge(ACK_DELAY);
+            break;
+
+        // ReadTOC
+        case 0x1E:
+            acknowledge(ACK_DELAY);
+            queue(ACK_DELAY + TOC_DELAY, 2, {status()});
+            break;
+
+        default:
+            error(ERR_BAD_COMMAND);
+            break;
+    }
+}
+
+// --- Interrupt delivery ---
+
+void CDROM::onResponse(void* ctx, uint64_t now) {
+    static_cast<CDROM*>(ctx)->deliver(now);
+}
+
+// A response only becomes visible once the previous interrupt is acknowledged
+void CDROM::deliver(uint64_t now) {
+    if (irq_flag != 0 || pending.empty()) return;
+
+    const Response& r = pending.front();
+    if (r.due > now) {
+        scheduleDelivery();
+        return;
+    }
+
+    response = r.bytes;
+    response_size = r.size;
+    response_pos = 0;
+    irq_flag = r.irq;
+    if (r.ack) busy = false;
+    if (r.sector != NO_SECTOR) ready_sector = r.sector;
+    pending.pop_front();
+
+    if (irq_flag & irq_enable) bus->interrupts.request(IRQ::CDROM);
+}
+
+void CDROM::scheduleDelivery() {
+    if (irq_flag != 0 || pending.empty()) return;
+    bus->scheduler.scheduleAt(Event::CDROM, std::max(pending.front().due, bus->scheduler.timestamp()));
+}
+
+// The drive has a single sector buffer: an unread INT1 is overwritten by the next one
+void CDROM::dropSectors() {
+    pending.erase(std::remove_if(pending.begin(), pending.end(), [](const Response& r) { return r.sector != NO_SECTOR; }),
+                  pending.end());
+}
+
+void CDROM::queueSector(uint32_t lba) {
+    dropSectors();
+    Response r;
+    r.due = bus->scheduler.timestamp();
+    r.irq = 1;
+    r.size = 1;
+    r.ack = false;
+    r.sector = lba;
+    r.bytes[0] = status();
+    insert(r);
+}
+
+// --- Drive ---
+
+uint8_t CDROM::status() const {
+    uint8_t stat = motor ? STAT_MOTOR : 0;
+    if (!disc || shell_opened) stat |= STAT_SHELL_OPEN;
+
+    switch (drive) {
+        case Drive::Seeking: stat |= STAT_SEEKING; break;
+        case Drive::Reading: stat |= STAT_READING; break;
+        case Drive::Playing: stat |= STAT_PLAYING; break;
+        case Drive::Idle: break;
+    }
+    return stat;
+}
+
+uint32_t CDROM::sectorPeriod() const {
+    return (mode & MODE_DOUBLE_SPEED) ? SECTOR_CYCLES / 2 : SECTOR_CYCLES;
+}
+
+void CDROM::startSeek(Drive then, bool report) {
+    const uint32_t distance = position > seek_target ? position - seek_target : seek_target - position;
+    uint64_t delay = SEEK_MIN_DELAY + distance * SEEK_CYCLES_PER_SECTOR;
+    if (!motor) delay += SPIN_UP_DELAY;
+
+    motor = true;
+    drive = Drive::Seeking;
+    after_seek = then;
+    seek_report = report;
+    position = seek_target;
+    dropSectors();
+
+    // Usually already requested by Setloc; cheap to repeat if the speed changed since
+    disc->prefetch(seek_target, (mode & MODE_DOUBLE_SPEED) ? 150 : 75);
+    bus->scheduler.schedule(Event::CDROMSector, delay);
+}
+
+void CDROM::stopDrive() {
+    drive = Drive::Idle;
+    bus->scheduler.cancel(Event::CDROMSector);
+    dropSectors();
+}
+
+void CDROM::onSector(void* ctx, uint64_t) {
+    CDROM* cd = static_cast<CDROM*>(ctx);
+
+    switch (cd->drive) {
+        case Drive::Seeking:
+            cd->drive = cd->after_seek;
+            if (cd->drive == Drive::Idle) {
+                if (cd->seek_report) cd->queue(0, 2, {cd->status()});
+            } else {
+                cd->bus->scheduler.schedule(Event::CDROMSector, cd->sectorPeriod());
+            }
+            break;
+
+        case Drive::Reading:
+            cd->readNextSector();
+            break;
+
+        // CD-DA is not mixed yet; the head only moves along the track
+        case Drive::Playing: {
+            const Track& track = cd->disc->trackAt(cd->position);
+            cd->position++;
+            if ((cd->mode & MODE_AUTOPAUSE) && cd->position >= track.start + track.length) {
+                cd->drive = Drive::Idle;
+                cd->queue(0, 4, {cd->status()});
+            } else {
+                cd->bus->scheduler.schedule(Event::CDROMSector, cd->sectorPeriod());
+            }
+            break;
+        }
+
+        case Drive::Idle:
+            break;
+    }
+}
+
+void CDROM::readNextSector() {
+    if (position >= disc->getSectorCount()) {
+        drive = Drive::Idle;
+        queue(0, 4, {status()});
+        return;
+    }
+
+    const uint8_t* sector = disc->readSector(position, buffers[drive_buffer].data());
+    std::copy(sector + 12, sector + 20, last_header.begin());
+    drive_sector = sector;
+    drive_lba = position;
+    const uint32_t lba = position++;
+    bus->scheduler.schedule(Event::CDROMSector, sectorPeriod());
+
+    // Real-time XA audio sectors go to the ADPCM decoder, never to the host
+    const bool xa_audio = sector[15] == 2 && (sector[18] & 0x44) == 0x44;
+    if ((mode & MODE_XA_ADPCM) && xa_audio) return;
+
+    queueSector(lba);
+}
@@ -0,0 +1,210 @@
+/*
+    Description: CD Image Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "disc_image.hpp"
+#include "bin_source.hpp"
+#include "ecm_source.hpp"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // How far ahead of the drive to fetch. Generous, since the image may live on
+    // network storage where one synchronous miss costs milliseconds.
+    constexpr uint32_t READ_AHEAD_MS = 2000;
+
+    constexpr uint8_t SILENCE[SectorSource::SECTOR_SIZE] = {};
+
+    std::string lowercase(std::string s) {
+        std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+        return s;
+    }
+
+    bool endsWith(const std::string& s, const std::string& suffix) {
+        return s.size() >= suffix.size() && lowercase(s.substr(s.size() - suffix.size())) == suffix;
+    }
+
+    std::string directoryOf(const std::string& path) {
+        const size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    }
+
+    // "mm:ss:ff" -> frames
+    bool parseMSF(const std::string& text, uint32_t& frames) {
+        unsigned mm, ss, ff;
+        char c1, c2;
+        std::istringstream in(text);
+        if (!(in >> mm >> c1 >> ss >> c2 >> ff) || c1 != ':' || c2 != ':') return false;
+        frames = (mm * 60 + ss) * 75 + ff;
+        return true;
+    }
+
+    // FILE "name with spaces.bin" BINARY
+    std::string quotedName(const std::string& line, std::istringstream& rest) {
+        const size_t first = line.find('"');
+        const size_t last = line.rfind('"');
+        if (first != std::string::npos && last > first) {
+            return line.substr(first + 1, last - first - 1);
+        }
+        std::string name;
+        rest >> name;
+        return name;
+    }
+}
+
+std::unique_ptr<DiscImage> DiscImage::open(const std::string& path) {
+    std::unique_ptr<DiscImage> disc(new DiscImage());
+
+    const bool ok = endsWith(path, ".cue") ? disc->parseCue(path) : disc->openSingle(path);
+    if (!ok) return nullptr;
+
+    disc->finishTracks();
+    return disc;
+}
+
+std::unique_ptr<SectorSource> DiscImage::openSource(const std::string& path) {
+    if (endsWith(path, ".ecm")) {
+        auto ecm = std::make_unique<EcmSource>();
+        if (ecm->open(path)) return ecm;
+    } else {
+        auto bin = std::make_unique<BinSource>();
+        if (bin->open(path)) return bin;
+
+        // Cue sheets keep naming the .bin after it has been compressed
+        auto ecm = std::make_unique<EcmSource>();
+        if (ecm->open(path + ".ecm")) return ecm;
+    }
+
+    std::cerr << "[CDROM] Cannot open image file: " << path << std::endl;
+    return nullptr;
+}
+
+bool DiscImage::openSingle(const std::string& path) {
+    std::unique_ptr<SectorSource> source = openSource(path);
+    if (!source) return false;
+
+    sector_count = source->sectors();
+    segments.push_back({0, sector_count, source.get(), 0});
+    tracks.push_back({1, false, 0, 0});
+    sources.push_back(std::move(source));
+    return true;
+}
+
+bool DiscImage::parseCue(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "[CDROM] Cannot open cue sheet: " << path << std::endl;
+        return false;
+    }
+
+    const std::string dir = directoryOf(path);
+
+    SectorSource* file = nullptr;
+    uint32_t emitted = 0;       // Sectors of the current file already laid out
+    uint32_t lba = 0;           // Next disc LBA to lay out
+    uint32_t pregap = 0;        // PREGAP of the current track (not stored in the file)
+    uint8_t track_number = 0;
+    bool track_audio = false;
+
+    auto layOut = [&](uint32_t until) {
+        if (file && until > emitted) {
+            segments.push_back({lba, until - emitted, file, emitted});
+            lba += until - emitted;
+            emitted = until;
+        }
+    };
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream tokens(line);
+        std::string keyword;
+        tokens >> keyword;
+        keyword = lowercase(keyword);
+
+        if (keyword == "file") {
+            layOut(file ? file->sectors() : 0);
+
+            std::unique_ptr<SectorSource> source = openSource(dir + quotedName(line, tokens));
+            if (!source) return false;
+            file = source.get();
+            emitted = 0;
+            sources.push_back(std::move(source));
+        } else if (keyword == "track") {
+            unsigned number = 0;
+            std::string type;
+            tokens >> number >> type;
+            track_number = static_cast<uint8_t>(number);
+            track_audio = lowercase(type) == "audio";
+        } else if (keyword == "pregap") {
+            std::string msf;
+            tokens >> msf;
+            if (!parseMSF(msf, pregap)) pregap = 0;
+        } else if (keyword == "index") {
+            unsigned number = 0;
+            std::string msf;
+            uint32_t position;
+            tokens >> number >> msf;
+            if (number != 1 || !file || !parseMSF(msf, position)) continue;
+
+            // INDEX 00 data (a stored pregap) is laid out as part of the previous track
+            layOut(position);
+            if (pregap > 0) {
+                segments.push_back({lba, pregap, nullptr, 0});
+                lba += pregap;
+                pregap = 0;
+            }
+            tracks.push_back({track_number, track_audio, lba, 0});
+        }
+    }
+    layOut(file ? file->sectors() : 0);
+
+    sector_count = lba;
+    if (tracks.empty() || sector_count == 0) {
+        std::cerr << "[CDROM] Cue sheet has no usable tracks: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void DiscImage::finishTracks() {
+    for (size_t i = 0; i < tracks.size(); i++) {
+        const uint32_t end = (i + 1 < tracks.size()) ? tracks[i + 1].start : sector_count;
+        tracks[i].length = end > tracks[i].start ? end - tracks[i].start : 0;
+    }
+}
+
+const DiscImage::Segment* DiscImage::segmentAt(uint32_t lba) const {
+    auto it = std::upper_bound(segments.begin(), segments.end(), lba,
+                               [](uint32_t value, const Segment& s) { return value < s.start; });
+    if (it == segments.begin()) return nullptr;
+    --it;
+    return lba < it->start + it->count ? &*it : nullptr;
+}
+
+const uint8_t* DiscImage::readSector(uint32_t lba, uint8_t* scratch) {
+    const Segment* segment = segmentAt(lba);
+    if (!segment || !segment->source) return SILENCE;
+
+    const uint8_t* sector = segment->source->read(segment->first + (lba - segment->start), scratch);
+    return sector ? sector : SILENCE;
+}
+
+void DiscImage::prefetch(uint32_t lba, uint32_t sectors_per_second) {
+    ahead = sectors_per_second * READ_AHEAD_MS / 1000;
+
+    const Segment* segment = segmentAt(lba);
+    if (segment && segment->source) {
+        segment->source->prefetch(segment->first + (lba - segment->start), ahead);
+    }
+}
+
+const Track& DiscImage::trackAt(uint32_t lba) const {
+    auto it = std::upper_bound(tracks.begin(), tracks.end(), lba,
+                               [](uint32_t value, const Track& t) { return value < t.start; });
+    return it == tracks.begin() ? tracks.front() : *(it - 1);
+}
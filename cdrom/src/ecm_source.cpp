@@ -0,0 +1,267 @@
+/*
+    Description: ECM Compressed Sector Source Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "ecm_source.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Record types: literal bytes, Mode 1 sector, Mode 2 Form 1, Mode 2 Form 2
+    constexpr uint32_t TYPE_LITERAL = 0;
+    constexpr uint32_t TYPE_MODE1 = 1;
+    constexpr uint32_t TYPE_FORM1 = 2;
+    constexpr uint32_t TYPE_FORM2 = 3;
+
+    // Stored payload per sector of each type, and what it expands to. Mode 2
+    // records carry no sync/header, so they expand to 2336 bytes.
+    constexpr uint32_t PAYLOAD[4] = {1, 0x803, 0x804, 0x918};
+    constexpr uint32_t EXPANDED[4] = {1, 2352, 2336, 2336};
+
+    struct Tables {
+        uint8_t ecc_f[256];
+        uint8_t ecc_b[256];
+        uint32_t edc[256];
+    };
+
+    constexpr Tables makeTables() {
+        Tables t{};
+        for (uint32_t i = 0; i < 256; i++) {
+            const uint32_t j = (i << 1) ^ ((i & 0x80) ? 0x11D : 0);
+            t.ecc_f[i] = static_cast<uint8_t>(j);
+            t.ecc_b[i ^ j] = static_cast<uint8_t>(i);
+
+            uint32_t edc = i;
+            for (int k = 0; k < 8; k++) {
+                edc = (edc >> 1) ^ ((edc & 1) ? 0xD8018001 : 0);
+            }
+            t.edc[i] = edc;
+        }
+        return t;
+    }
+
+    constexpr Tables TABLES = makeTables();
+
+    void computeEDC(const uint8_t* src, size_t size, uint8_t* dst) {
+        uint32_t edc = 0;
+        for (size_t i = 0; i < size; i++) {
+            edc = (edc >> 8) ^ TABLES.edc[(edc ^ src[i]) & 0xFF];
+        }
+        dst[0] = static_cast<uint8_t>(edc);
+        dst[1] = static_cast<uint8_t>(edc >> 8);
+        dst[2] = static_cast<uint8_t>(edc >> 16);
+        dst[3] = static_cast<uint8_t>(edc >> 24);
+    }
+
+    // One Reed-Solomon parity set (P: 86x24, Q: 52x43) over the header + data
+    void computeECC(const uint8_t* src, uint32_t major_count, uint32_t minor_count,
+                    uint32_t major_mult, uint32_t minor_inc, uint8_t* dst) {
+        const uint32_t size = major_count * minor_count;
+        for (uint32_t major = 0; major < major_count; major++) {
+            uint32_t index = (major >> 1) * major_mult + (major & 1);
+            uint8_t a = 0, b = 0;
+            for (uint32_t minor = 0; minor < minor_count; minor++) {
+                const uint8_t value = src[index];
+                index += minor_inc;
+                if (index >= size) index -= size;
+                a ^= value;
+                b ^= value;
+                a = TABLES.ecc_f[a];
+            }
+            a = TABLES.ecc_b[TABLES.ecc_f[a] ^ b];
+            dst[major] = a;
+            dst[major + major_count] = a ^ b;
+        }
+    }
+
+    void generateECC(uint8_t* sector, bool zero_address) {
+        uint8_t address[4] = {};
+        if (zero_address) {
+            std::memcpy(address, sector + 12, 4);
+            std::memset(sector + 12, 0, 4);
+        }
+        computeECC(sector + 0xC, 86, 24, 2, 86, sector + 0x81C);
+        computeECC(sector + 0xC, 52, 43, 86, 88, sector + 0x8C8);
+        if (zero_address) {
+            std::memcpy(sector + 12, address, 4);
+        }
+    }
+
+    // Rebuild a full 2352-byte sector from an ECM payload
+    void rebuildSector(uint32_t type, const uint8_t* payload, uint8_t* sector) {
+        static constexpr uint8_t SYNC[12] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+        std::memcpy(sector, SYNC, sizeof(SYNC));
+
+        switch (type) {
+            case TYPE_MODE1:
+                std::memcpy(sector + 0xC, payload, 3);
+                sector[0xF] = 1;
+                std::memcpy(sector + 0x10, payload + 3, 0x800);
+                computeEDC(sector, 0x810, sector + 0x810);
+                std::memset(sector + 0x814, 0, 8);
+                generateECC(sector, false);
+                break;
+            case TYPE_FORM1:
+                sector[0xF] = 2;
+                std::memcpy(sector + 0x14, payload, 0x804);
+                std::memcpy(sector + 0x10, sector + 0x14, 4);
+                computeEDC(sector + 0x10, 0x808, sector + 0x818);
+                generateECC(sector, true);
+                break;
+            case TYPE_FORM2:
+                sector[0xF] = 2;
+                std::memcpy(sector + 0x14, payload, 0x918);
+                std::memcpy(sector + 0x10, sector + 0x14, 4);
+                computeEDC(sector + 0x10, 0x91C, sector + 0x92C);
+                break;
+        }
+    }
+}
+
+EcmSource::~EcmSource() {
+    if (worker.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        wake.notify_all();
+        worker.join();
+    }
+}
+
+bool EcmSource::open(const std::string& path) {
+    if (!file.open(path)) return false;
+
+    if (file.size() < 4 || std::memcmp(file.data(), "ECM\0", 4) != 0 || !buildIndex()) {
+        std::cerr << "[CDROM] Not a valid ECM image: " << path << std::endl;
+        return false;
+    }
+
+    cache.resize(CACHE_SECTORS);
+    worker = std::thread(&EcmSource::workerLoop, this);
+    return true;
+}
+
+bool EcmSource::buildIndex() {
+    const uint8_t* data = file.data();
+    const size_t size = file.size();
+    size_t pos = 4;
+    uint64_t out_offset = 0;
+
+    // Only record headers are touched; payloads are skipped by their known size
+    for (;;) {
+        if (pos >= size) return false;
+        uint8_t c = data[pos++];
+        const uint32_t type = c & 3;
+        uint64_t num = (c >> 2) & 0x1F;
+        int bits = 5;
+        while (c & 0x80) {
+            if (pos >= size || bits > 32) return false;
+            c = data[pos++];
+            num |= static_cast<uint64_t>(c & 0x7F) << bits;
+            bits += 7;
+        }
+        if (num == 0xFFFFFFFF) break;
+        num++;
+
+        const uint64_t in_bytes = num * PAYLOAD[type];
+        if (pos + in_bytes > size) return false;
+
+        records.push_back({out_offset, num * EXPANDED[type], pos, type});
+        out_offset += num * EXPANDED[type];
+        pos += in_bytes;
+    }
+
+    sector_count = static_cast<uint32_t>(out_offset / SECTOR_SIZE);
+    return sector_count > 0;
+}
+
+void EcmSource::decode(uint64_t offset, uint8_t* dst, size_t count) const {
+    auto it = std::upper_bound(records.begin(), records.end(), offset,
+                               [](uint64_t value, const Record& r) { return value < r.out_offset; }) - 1;
+
+    uint8_t sector[SECTOR_SIZE];
+    while (count > 0 && it != records.end()) {
+        const uint64_t within = offset - it->out_offset;
+        size_t run;
+
+        if (it->type == TYPE_LITERAL) {
+            run = static_cast<size_t>(std::min<uint64_t>(count, it->out_bytes - within));
+            std::memcpy(dst, file.data() + it->in_offset + within, run);
+        } else {
+            const uint32_t unit = EXPANDED[it->type];
+            const uint64_t n = within / unit;
+            const uint32_t at = static_cast<uint32_t>(within % unit);
+            rebuildSector(it->type, file.data() + it->in_offset + n * PAYLOAD[it->type], sector);
+
+            // Mode 2 records expand to the sector minus sync and header
+            const uint8_t* expanded = it->type == TYPE_MODE1 ? sector : sector + 0x10;
+            run = std::min<size_t>(count, unit - at);
+            std::memcpy(dst, expanded + at, run);
+        }
+
+        offset += run;
+        dst += run;
+        count -= run;
+        if (offset >= it->out_offset + it->out_bytes) ++it;
+    }
+}
+
+void EcmSource::fill(Slot& slot, uint32_t index, std::unique_lock<std::mutex>& lock) {
+    slot.index = index;
+    slot.busy = true;
+    lock.unlock();
+
+    decode(static_cast<uint64_t>(index) * SECTOR_SIZE, slot.data.data(), SECTOR_SIZE);
+
+    lock.lock();
+    slot.busy = false;
+    filled.notify_all();
+}
+
+const uint8_t* EcmSource::read(uint32_t index, uint8_t* scratch) {
+    if (index >= sector_count) return nullptr;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    Slot& slot = cache[index % CACHE_SECTORS];
+    filled.wait(lock, [&] { return !slot.busy; });
+    if (slot.index != index) {
+        fill(slot, index, lock);
+    }
+
+    std::memcpy(scratch, slot.data.data(), SECTOR_SIZE);
+
+    // Slide the read-ahead window along with a sequential reader
+    if (ahead > 0 && index + ahead / 2 >= ahead_end) {
+        ahead_next = std::max(ahead_next, index + 1);
+        ahead_end = std::min(index + 1 + ahead, sector_count);
+        wake.notify_one();
+    }
+    return scratch;
+}
+
+void EcmSource::prefetch(uint32_t index, uint32_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // A window larger than half the cache would evict its own start
+    ahead = std::min(count, CACHE_SECTORS / 2);
+    ahead_next = index;
+    ahead_end = std::min(index + ahead, sector_count);
+    wake.notify_one();
+}
+
+void EcmSource::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [&] { return quit || ahead_next < ahead_end; });
+        if (quit) return;
+
+        const uint32_t index = ahead_next++;
+        Slot& slot = cache[index % CACHE_SECTORS];
+        if (slot.busy || slot.index == index) continue;
+        fill(slot, index, lock);
+    }
+}
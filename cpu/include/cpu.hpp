@@ -8,8 +8,10 @@
 
 #include "registers.hpp"
 #include "bus.hpp"
+#include "gte.hpp"
 #include <array>
 #include <functional>
+#include <unordered_set>
 
 class CPU;
 using InstructionHandler = void (*)(CPU&);
@@ -39,26 +41,45 @@ class CPU {
 
         void scheduleLoad(uint32_t reg, uint32_t value);
 
+        // Stop before the next instruction (breakpoints, watchpoints). A resumed
+        // CPU runs through a breakpoint at the PC it stopped on.
+        void halt() { halted = true; }
+        void resume() { halted = false; skip_breakpoint = true; }
+        bool isHalted() const { return halted; }
+
+        // PC breakpoints by physical address; fetch only looks them up while
+        // at least one is set
+        void setBreakpoint(uint32_t phys, bool enabled);
+
 #ifdef DEBUG
         void dumpRegisters();
 #endif
 
     private:
-        void fetch();
+        bool fetch();
         void decode();
         void execute();
 
     public:
         Bus* bus = nullptr;
         Registers registers;
+        GTE gte;
 
         uint32_t instr, next_pc;
+        uint32_t current_pc = 0;    // Address of `instr`, the instruction executing now
 
         std::array<InstructionHandler, 64> pri_table, sec_table;
     
+        // Average cost of one instruction in master clock cycles (no cache/wait-state model yet)
+        static constexpr uint32_t CYCLES_PER_INSTR = 2;
+
     private:
         int cycles;
         uint32_t pri_opcode, sec_opcode;
 
+        std::unordered_set<uint32_t> breakpoints;
+        bool halted = false;
+        bool skip_breakpoint = false;
+
         std::vector<LoadEntry> pending_loads;
 };
@@ -7,7 +7,7 @@
 #pragma once
 
 #include "cpu.hpp"
-#include <iostream>
+#include "log.hpp"
 #include <cassert>
 
 // --- Bit Manipulation Helpers ---
@@ -48,17 +48,17 @@ namespace Instructions {
     // --- Core Logic ---
 
     static void illegal(CPU& cpu) {
-        std::cerr << "Illegal Instruction: 0x" << std::hex << cpu.instr << " at PC: 0x" << cpu.registers.pc - 4 << std::endl;
-
-        uint32_t pri = cpu.instr >> 26;
-        uint32_t sec = cpu.instr & 0x3F;
-
-        std::cerr << "Primary opcode: 0x" << std::hex << pri << ", Secondary opcode: 0x" << std::hex << sec << std::endl;
+        LOG_ERROR("CPU", "Illegal instruction 0x{x} at PC 0x{x} (primary 0x{x}, secondary 0x{x})",
+                  cpu.instr, cpu.current_pc, cpu.instr >> 26, cpu.instr & 0x3F);
 
+        // TODO: Raise Exception Code 0x0A (Reserved Instruction)
+#ifndef NDEBUG
+        // The assert aborts: get the record and the code around it out first
+        Log::flush();
         if (cpu.bus) {
-            cpu.bus->dumpMemoryRegion(cpu.registers.pc - 4, 0xff);
+            cpu.bus->dumpMemoryRegion(cpu.current_pc, 0xff);
         }
-        // TODO: Raise Exception Code 0x0A (Reserved Instruction)
+#endif
         assert(false && "Illegal Instruction Encountered");
     }
 
@@ -328,7 +328,12 @@ namespace Instructions {
                 // We implement the critical registers for BIOS booting
                 switch (rd) {
                     case 12: set_reg(cpu, rt, cpu.registers.sr); break;
-                    case 13: set_reg(cpu, rt, cpu.registers.cause); break;
+                    case 13: {
+                        // IP2 mirrors the interrupt controller line
+                        uint32_t ip2 = cpu.bus->interrupts.pending() ? (1u << 10) : 0;
+                        set_reg(cpu, rt, (cpu.registers.cause & ~(1u << 10)) | ip2);
+                        break;
+                    }
                     case 14: set_reg(cpu, rt, cpu.registers.epc); break;
                     default: 
                         // Fallback for unhandled registers
@@ -351,11 +356,46 @@ namespace Instructions {
                 break;
 
             default:
-                std::cerr << "[CPU] Unhandled COP0 instruction: 0x" << std::hex << cpu.instr << std::endl;
+                LOG_WARN("CPU", "Unhandled COP0 instruction 0x{x} at PC 0x{x}", cpu.instr, cpu.current_pc);
+                break;
+        }
+    }
+
+    // 0x12: COP2 (GTE)
+    static void cop2(CPU& cpu) {
+        // Bit 25 set: imm25 GTE command
+        if (cpu.instr & (1u << 25)) {
+            cpu.gte.execute(cpu.instr & 0x1FFFFFF);
+            return;
+        }
+
+        uint32_t rs = OP_RS(cpu.instr);
+        uint32_t rd = OP_RD(cpu.instr);
+        uint32_t rt = OP_RT(cpu.instr);
+
+        switch (rs) {
+            case 0x00: cpu.scheduleLoad(rt, cpu.gte.readData(rd)); break;      // MFC2
+            case 0x02: cpu.scheduleLoad(rt, cpu.gte.readControl(rd)); break;   // CFC2
+            case 0x04: cpu.gte.writeData(rd, get_reg(cpu, rt)); break;         // MTC2
+            case 0x06: cpu.gte.writeControl(rd, get_reg(cpu, rt)); break;      // CTC2
+            default:
+                LOG_WARN("CPU", "Unhandled COP2 instruction 0x{x} at PC 0x{x}", cpu.instr, cpu.current_pc);
                 break;
         }
     }
 
+    // 0x32: LWC2 gte[rt], imm(rs)
+    static void lwc2(CPU& cpu) {
+        uint32_t addr = get_reg(cpu, OP_RS(cpu.instr)) + sign_extend(OP_IMM16(cpu.instr));
+        cpu.gte.writeData(OP_RT(cpu.instr), cpu.read32(addr));
+    }
+
+    // 0x3A: SWC2 gte[rt], imm(rs)
+    static void swc2(CPU& cpu) {
+        uint32_t addr = get_reg(cpu, OP_RS(cpu.instr)) + sign_extend(OP_IMM16(cpu.instr));
+        cpu.write32(addr, cpu.gte.readData(OP_RT(cpu.instr)));
+    }
+
     // 0x05: BNE
     static void bne(CPU& cpu) {
         uint32_t s = get_reg(cpu, OP_RS(cpu.instr));
@@ -37,7 +37,7 @@ static void init_opcodes(CPU& cpu) {
 
     // cpu.pri_table[0x10] = &cop0;
     // cpu.pri_table[0x11] = &cop1;
-    // cpu.pri_table[0x12] = &cop2;
+    cpu.pri_table[0x12] = &cop2;
     // cpu.pri_table[0x13] = &cop3;
     
     cpu.pri_table[0x20] = &lb;
@@ -54,6 +54,9 @@ static void init_opcodes(CPU& cpu) {
     cpu.pri_table[0x2B] = &sw;
     cpu.pri_table[0x2E] = &swr;
 
+    cpu.pri_table[0x32] = &lwc2;
+    cpu.pri_table[0x3A] = &swc2;
+
     // 3. Secondary Opcodes (Function Field) Mapping
     
     // cpu.sec_table[0x00] = &sll;
@@ -5,8 +5,7 @@
 */
 
 #include "cpu.hpp"
-#include <iostream>
-#include <iomanip>
+#include "log.hpp"
 
 CPU::CPU(Bus* bus) : bus(bus) {
     cycles = 0;
@@ -20,11 +19,15 @@ void CPU::init() {
     // }
     // registers.pc = 0xbfc00000;
     next_pc = registers.pc + 4;
+    current_pc = registers.pc;
     pending_loads.clear();
+    halted = false;
+    skip_breakpoint = false;
+    gte.init();
 }
 
 void CPU::step() {
-    fetch();
+    if (!fetch()) return;
     decode();
 
     for (auto it = pending_loads.begin(); it != pending_loads.end(); ) {
@@ -40,12 +43,32 @@ void CPU::step() {
     }
 
     execute();
+
+    bus->scheduler.advance(CYCLES_PER_INSTR);
 }
 
-void CPU::fetch() {
+// Returns false when a breakpoint stopped the CPU before the instruction
+bool CPU::fetch() {
+    if (!breakpoints.empty()) {
+        const bool skip = skip_breakpoint;
+        skip_breakpoint = false;
+        if (!skip && breakpoints.count(registers.pc & 0x1FFFFFFF)) {
+            LOG_INFO("CPU", "Breakpoint at PC 0x{x}", registers.pc);
+            halted = true;
+            return false;
+        }
+    }
+
     instr = bus->read32(registers.pc);
+    current_pc = registers.pc;
     registers.pc = next_pc;
     next_pc += 4;
+    return true;
+}
+
+void CPU::setBreakpoint(uint32_t phys, bool enabled) {
+    if (enabled) breakpoints.insert(phys);
+    else breakpoints.erase(phys);
 }
 
 void CPU::decode() {
@@ -87,40 +110,14 @@ void CPU::scheduleLoad(uint32_t reg, uint32_t value) {
 
 #ifdef DEBUG
 void CPU::dumpRegisters() {
-    std::cout << "[Register] zero value:\t 0x" << std::hex << registers.zero << std::endl;
-    std::cout << "[Register] at value:\t 0x" << std::hex << registers.at << std::endl;
-    std::cout << "[Register] v0 value:\t 0x" << std::hex << registers.v0 << std::endl;
-    std::cout << "[Register] v1 value:\t 0x" << std::hex << registers.v1 << std::endl;
-    std::cout << "[Register] a0 value:\t 0x" << std::hex << registers.a0 << std::endl;
-    std::cout << "[Register] a1 value:\t 0x" << std::hex << registers.a1 << std::endl;
-    std::cout << "[Register] a2 value:\t 0x" << std::hex << registers.a2 << std::endl;
-    std::cout << "[Register] a3 value:\t 0x" << std::hex << registers.a3 << std::endl;
-    std::cout << "[Register] t0 value:\t 0x" << std::hex << registers.t0 << std::endl;
-    std::cout << "[Register] t1 value:\t 0x" << std::hex << registers.t1 << std::endl;
-    std::cout << "[Register] t2 value:\t 0x" << std::hex << registers.t2 << std::endl;
-    std::cout << "[Register] t3 value:\t 0x" << std::hex << registers.t3 << std::endl;
-    std::cout << "[Register] t4 value:\t 0x" << std::hex << registers.t4 << std::endl;
-    std::cout << "[Register] t5 value:\t 0x" << std::hex << registers.t5 << std::endl;
-    std::cout << "[Register] t6 value:\t 0x" << std::hex << registers.t6 << std::endl;
-    std::cout << "[Register] t7 value:\t 0x" << std::hex << registers.t7 << std::endl;
-    std::cout << "[Register] s0 value:\t 0x" << std::hex << registers.s0 << std::endl;
-    std::cout << "[Register] s1 value:\t 0x" << std::hex << registers.s1 << std::endl;
-    std::cout << "[Register] s2 value:\t 0x" << std::hex << registers.s2 << std::endl;
-    std::cout << "[Register] s3 value:\t 0x" << std::hex << registers.s3 << std::endl;
-    std::cout << "[Register] s4 value:\t 0x" << std::hex << registers.s4 << std::endl;
-    std::cout << "[Register] s5 value:\t 0x" << std::hex << registers.s5 << std::endl;
-    std::cout << "[Register] s6 value:\t 0x" << std::hex << registers.s6 << std::endl;
-    std::cout << "[Register] s7 value:\t 0x" << std::hex << registers.s7 << std::endl;
-    std::cout << "[Register] t8 value:\t 0x" << std::hex << registers.t8 << std::endl;
-    std::cout << "[Register] t9 value:\t 0x" << std::hex << registers.t9 << std::endl;
-    std::cout << "[Register] k0 value:\t 0x" << std::hex << registers.k0 << std::endl;
-    std::cout << "[Register] k1 value:\t 0x" << std::hex << registers.k1 << std::endl;
-    std::cout << "[Register] gp value:\t 0x" << std::hex << registers.gp << std::endl;
-    std::cout << "[Register] sp value:\t 0x" << std::hex << registers.sp << std::endl;
-    std::cout << "[Register] fp_s8 value:\t 0x" << std::hex << registers.fp_s8 << std::endl;
-    std::cout << "[Register] ra value:\t 0x" << std::hex << registers.ra << std::endl;
-    std::cout << "[Register] pc value:\t 0x" << std::hex << registers.pc << std::endl;
-    std::cout << "[Register] hi value:\t 0x" << std::hex << registers.hi << std::endl;
-    std::cout << "[Register] lo value:\t 0x" << std::hex << registers.lo << std::endl;
+    LOG_DEBUG("Register", "r0 zero 0x{x}  r1 at 0x{x}  r2 v0 0x{x}  r3 v1 0x{x}", registers.r[0], registers.r[1], registers.r[2], registers.r[3]);
+    LOG_DEBUG("Register", "r4 a0 0x{x}  r5 a1 0x{x}  r6 a2 0x{x}  r7 a3 0x{x}", registers.r[4], registers.r[5], registers.r[6], registers.r[7]);
+    LOG_DEBUG("Register", "r8 t0 0x{x}  r9 t1 0x{x}  r10 t2 0x{x}  r11 t3 0x{x}", registers.r[8], registers.r[9], registers.r[10], registers.r[11]);
+    LOG_DEBUG("Register", "r12 t4 0x{x}  r13 t5 0x{x}  r14 t6 0x{x}  r15 t7 0x{x}", registers.r[12], registers.r[13], registers.r[14], registers.r[15]);
+    LOG_DEBUG("Register", "r16 s0 0x{x}  r17 s1 0x{x}  r18 s2 0x{x}  r19 s3 0x{x}", registers.r[16], registers.r[17], registers.r[18], registers.r[19]);
+    LOG_DEBUG("Register", "r20 s4 0x{x}  r21 s5 0x{x}  r22 s6 0x{x}  r23 s7 0x{x}", registers.r[20], registers.r[21], registers.r[22], registers.r[23]);
+    LOG_DEBUG("Register", "r24 t8 0x{x}  r25 t9 0x{x}  r26 k0 0x{x}  r27 k1 0x{x}", registers.r[24], registers.r[25], registers.r[26], registers.r[27]);
+    LOG_DEBUG("Register", "r28 gp 0x{x}  r29 sp 0x{x}  r30 fp 0x{x}  r31 ra 0x{x}", registers.r[28], registers.r[29], registers.r[30], registers.r[31]);
+    LOG_DEBUG("Register", "pc 0x{x}  hi 0x{x}  lo 0x{x}", registers.pc, registers.hi, registers.lo);
 }
 #endif
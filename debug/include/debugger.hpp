@@ -0,0 +1,58 @@
+/*
+    Description: Debugger Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class Bus;
+class CPU;
+
+enum class WatchKind : uint8_t {
+    Read = 1,
+    Write = 2,
+    ReadWrite = 3
+};
+
+struct Watchpoint {
+    uint32_t start;     // Physical address
+    uint32_t size;
+    WatchKind kind;
+};
+
+// PC breakpoints and memory watchpoints that cost nothing while none is set.
+// A watched 64KB page is dropped from the bus fast path, so only accesses to
+// that page reach the checks here; the CPU only looks up breakpoints while at
+// least one is set. A hit stops the CPU after the access (watchpoints) or
+// before the instruction (breakpoints).
+class Debugger {
+    public:
+        Debugger(Bus* bus, CPU* cpu);
+
+        void addBreakpoint(uint32_t address);
+        void removeBreakpoint(uint32_t address);
+
+        void addWatchpoint(uint32_t address, uint32_t size, WatchKind kind);
+        void removeWatchpoint(uint32_t address);
+
+        // Continue a stopped CPU
+        void resume();
+
+        // Called by the bus for accesses to diverted pages
+        void onRead(uint32_t phys, uint32_t size, uint32_t value);
+        void onWrite(uint32_t phys, uint32_t size, uint32_t value);
+
+    private:
+        void check(uint32_t phys, uint32_t size, uint32_t value, WatchKind kind);
+        void rewatch();
+
+        Bus* bus;
+        CPU* cpu;
+
+        std::vector<uint32_t> breakpoints;
+        std::vector<Watchpoint> watchpoints;
+};
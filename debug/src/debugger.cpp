@@ -0,0 +1,82 @@
+/*
+    Description: Debugger Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "debugger.hpp"
+#include "bus.hpp"
+#include "cpu.hpp"
+#include "log.hpp"
+#include <algorithm>
+
+namespace {
+    constexpr uint32_t physical(uint32_t address) { return address & 0x1FFFFFFF; }
+}
+
+Debugger::Debugger(Bus* bus, CPU* cpu) : bus(bus), cpu(cpu) {}
+
+void Debugger::addBreakpoint(uint32_t address) {
+    const uint32_t phys = physical(address) & ~3u;
+    if (std::find(breakpoints.begin(), breakpoints.end(), phys) != breakpoints.end()) return;
+    breakpoints.push_back(phys);
+    cpu->setBreakpoint(phys, true);
+}
+
+void Debugger::removeBreakpoint(uint32_t address) {
+    const uint32_t phys = physical(address) & ~3u;
+    auto it = std::find(breakpoints.begin(), breakpoints.end(), phys);
+    if (it == breakpoints.end()) return;
+    breakpoints.erase(it);
+    cpu->setBreakpoint(phys, false);
+}
+
+void Debugger::addWatchpoint(uint32_t address, uint32_t size, WatchKind kind) {
+    watchpoints.push_back({physical(address), std::max<uint32_t>(size, 1), kind});
+    rewatch();
+}
+
+void Debugger::removeWatchpoint(uint32_t address) {
+    const uint32_t phys = physical(address);
+    watchpoints.erase(std::remove_if(watchpoints.begin(), watchpoints.end(),
+                                     [&](const Watchpoint& w) { return w.start == phys; }),
+                      watchpoints.end());
+    rewatch();
+}
+
+void Debugger::resume() {
+    cpu->resume();
+}
+
+// Pages shared by several watchpoints stay diverted until the last one goes
+void Debugger::rewatch() {
+    bus->clearWatches();
+    for (const Watchpoint& w : watchpoints) {
+        bus->watchPages(w.start, w.size,
+                        static_cast<uint8_t>(w.kind) & static_cast<uint8_t>(WatchKind::Read),
+                        static_cast<uint8_t>(w.kind) & static_cast<uint8_t>(WatchKind::Write));
+    }
+}
+
+void Debugger::onRead(uint32_t phys, uint32_t size, uint32_t value) {
+    check(phys, size, value, WatchKind::Read);
+}
+
+void Debugger::onWrite(uint32_t phys, uint32_t size, uint32_t value) {
+    check(phys, size, value, WatchKind::Write);
+}
+
+void Debugger::check(uint32_t phys, uint32_t size, uint32_t value, WatchKind kind) {
+    for (const Watchpoint& w : watchpoints) {
+        if (!(static_cast<uint8_t>(w.kind) & static_cast<uint8_t>(kind))) continue;
+        if (phys + size <= w.start || phys >= w.start + w.size) continue;
+
+        if (kind == WatchKind::Read) {
+            LOG_INFO("Debug", "Read watchpoint 0x{x}: {} bytes at 0x{x} = 0x{x} from PC 0x{x}", w.start, size, phys, value, cpu->current_pc);
+        } else {
+            LOG_INFO("Debug", "Write watchpoint 0x{x}: {} bytes at 0x{x} = 0x{x} from PC 0x{x}", w.start, size, phys, value, cpu->current_pc);
+        }
+        cpu->halt();
+        return;
+    }
+}
@@ -0,0 +1,95 @@
+/*
+    Description: DMA Controller Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class Bus;
+
+enum class DMAChannel : uint32_t {
+    MDECin  = 0,
+    MDECout = 1,
+    GPU     = 2,
+    CDROM   = 3,
+    SPU     = 4,
+    PIO     = 5,
+    OTC     = 6,
+};
+
+// Device side of a channel. Transfers are handed over as contiguous word runs,
+// so a device sees one call per block (or linked-list packet), never one per word.
+// `words` points straight into main RAM whenever the run is contiguous.
+struct DMAPort {
+    void* ctx = nullptr;
+    void (*toDevice)(void* ctx, const uint32_t* words, uint32_t count) = nullptr;
+    void (*fromDevice)(void* ctx, uint32_t* words, uint32_t count) = nullptr;
+};
+
+class DMA {
+    public:
+        DMA(Bus* bus);
+        ~DMA();
+
+        void init();
+
+        void connect(DMAChannel channel, const DMAPort& port);
+
+        // Register interface (offset relative to 0x1F801080)
+        uint32_t read32(uint32_t offset);
+        void write32(uint32_t offset, uint32_t data);
+
+    private:
+        static constexpr int CHANNEL_COUNT = 7;
+        static constexpr uint32_t RAM_MASK = 0x1FFFFC;  // 2MB, word aligned
+
+        // CHCR fields
+        static constexpr uint32_t CHCR_FROM_RAM  = 1u << 0;
+        static constexpr uint32_t CHCR_BACKWARD  = 1u << 1;
+        static constexpr uint32_t CHCR_START     = 1u << 24;
+        static constexpr uint32_t CHCR_TRIGGER   = 1u << 28;
+
+        enum class SyncMode : uint32_t { Manual = 0, Request = 1, LinkedList = 2 };
+
+        struct Channel {
+            uint32_t madr;
+            uint32_t bcr;
+            uint32_t chcr;
+            DMAPort port;
+        };
+
+        bool isActive(int ch) const;
+        SyncMode syncMode(int ch) const { return static_cast<SyncMode>((channels[ch].chcr >> 9) & 3); }
+
+        void tryStart(int ch);
+        uint32_t runBlock(int ch);
+        uint32_t runLinkedList(int ch);
+        uint32_t runOTC(int ch);
+
+        void transferToDevice(Channel& c, uint32_t addr, uint32_t count, bool backward);
+        void transferFromDevice(Channel& c, uint32_t addr, uint32_t count, bool backward);
+
+        void complete(int ch);
+        void updateMasterFlag();
+
+        // Completion handlers need to know which channel fired; one instantiation per slot
+        template <int CH>
+        static void onComplete(void* ctx, uint64_t now) {
+            (void)now;
+            static_cast<DMA*>(ctx)->complete(CH);
+        }
+
+        Bus* bus = nullptr;
+        uint8_t* ram = nullptr;
+
+        std::array<Channel, CHANNEL_COUNT> channels;
+        uint32_t dpcr, dicr;
+
+        // Staging area for the rare backward / wrapping transfers
+        std::vector<uint32_t> bounce;
+};
@@ -0,0 +1,293 @@
+/*
+    Description: DMA Controller Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "dma.hpp"
+#include "bus.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    constexpr Event channelEvent(int ch) {
+        return static_cast<Event>(static_cast<int>(Event::DMA0) + ch);
+    }
+
+    // Upper bound on linked-list packets per transfer so a corrupt list cannot hang the emulator
+    constexpr uint32_t LINKED_LIST_LIMIT = 0x100000;
+}
+
+DMA::DMA(Bus* bus) : bus(bus) {
+    init();
+}
+
+DMA::~DMA() = default;
+
+void DMA::init() {
+    for (auto& c : channels) {
+        c.madr = 0;
+        c.bcr = 0;
+        c.chcr = 0;
+    }
+    channels[static_cast<int>(DMAChannel::OTC)].chcr = CHCR_BACKWARD;
+
+    dpcr = 0x07654321;  // Reset value: channel priorities 1..7, all disabled
+    dicr = 0;
+
+    if (!bus) return;
+
+    ram = bus->getRAM();
+
+    Scheduler& sched = bus->scheduler;
+    sched.registerEvent(channelEvent(0), &DMA::onComplete<0>, this);
+    sched.registerEvent(channelEvent(1), &DMA::onComplete<1>, this);
+    sched.registerEvent(channelEvent(2), &DMA::onComplete<2>, this);
+    sched.registerEvent(channelEvent(3), &DMA::onComplete<3>, this);
+    sched.registerEvent(channelEvent(4), &DMA::onComplete<4>, this);
+    sched.registerEvent(channelEvent(5), &DMA::onComplete<5>, this);
+    sched.registerEvent(channelEvent(6), &DMA::onComplete<6>, this);
+}
+
+void DMA::connect(DMAChannel channel, const DMAPort& port) {
+    channels[static_cast<int>(channel)].port = port;
+}
+
+uint32_t DMA::read32(uint32_t offset) {
+    int ch = (offset >> 4) & 0x7;
+    uint32_t reg = offset & 0xC;
+
+    if (ch == 7) {
+        switch (reg) {
+            case 0x0: return dpcr;
+            case 0x4: return dicr;
+            default:  return 0;
+        }
+    }
+
+    const Channel& c = channels[ch];
+    switch (reg) {
+        case 0x0: return c.madr;
+        case 0x4: return c.bcr;
+        case 0x8: return c.chcr;
+        default:  return 0;
+    }
+}
+
+void DMA::write32(uint32_t offset, uint32_t data) {
+    int ch = (offset >> 4) & 0x7;
+    uint32_t reg = offset & 0xC;
+
+    if (ch == 7) {
+        switch (reg) {
+            case 0x0:
+                dpcr = data;
+                for (int i = 0; i < CHANNEL_COUNT; i++) tryStart(i);
+                break;
+            case 0x4: {
+                // Bits 24-30 are acknowledged by writing 1, the rest are plain R/W
+                uint32_t flags = (dicr & 0x7F000000) & ~(data & 0x7F000000);
+                dicr = flags | (data & 0x00FF803F);
+                updateMasterFlag();
+                break;
+            }
+            default: break;
+        }
+        return;
+    }
+
+    Channel& c = channels[ch];
+    switch (reg) {
+        case 0x0: c.madr = data & 0xFFFFFF; break;
+        case 0x4: c.bcr = data; break;
+        case 0x8:
+            if (ch == static_cast<int>(DMAChannel::OTC)) {
+                // OTC only exposes start/trigger; it always runs backwards into RAM
+                c.chcr = (data & 0x51000000) | CHCR_BACKWARD;
+            } else {
+                c.chcr = data & 0x71770703;
+            }
+            tryStart(ch);
+            break;
+        default: break;
+    }
+}
+
+bool DMA::isActive(int ch) const {
+    const uint32_t chcr = channels[ch].chcr;
+    const bool enabled = (dpcr >> (4 * ch + 3)) & 1;
+
+    if (!enabled || !(chcr & CHCR_START)) return false;
+    if (syncMode(ch) == SyncMode::Manual) return (chcr & CHCR_TRIGGER) != 0;
+    return true;
+}
+
+void DMA::tryStart(int ch) {
+    if (!isActive(ch) || bus->scheduler.isScheduled(channelEvent(ch))) return;
+
+    // The trigger bit clears as soon as the transfer begins
+    channels[ch].chcr &= ~CHCR_TRIGGER;
+
+    // Data moves in one go; only the completion (busy bit + IRQ) is delayed so the
+    // CPU observes roughly the right transfer time without being stalled here.
+    uint32_t cycles;
+    if (ch == static_cast<int>(DMAChannel::OTC)) {
+        cycles = runOTC(ch);
+    } else if (syncMode(ch) == SyncMode::LinkedList) {
+        cycles = runLinkedList(ch);
+    } else {
+        cycles = runBlock(ch);
+    }
+
+    bus->scheduler.schedule(channelEvent(ch), std::max<uint32_t>(cycles, 1));
+}
+
+uint32_t DMA::runBlock(int ch) {
+    Channel& c = channels[ch];
+
+    uint32_t count;
+    if (syncMode(ch) == SyncMode::Manual) {
+        count = c.bcr & 0xFFFF;
+        if (count == 0) count = 0x10000;
+    } else {
+        uint32_t block_size = c.bcr & 0xFFFF;
+        uint32_t blocks = c.bcr >> 16;
+        if (block_size == 0) block_size = 0x10000;
+        count = block_size * blocks;
+    }
+
+    const bool backward = (c.chcr & CHCR_BACKWARD) != 0;
+    const uint32_t addr = c.madr & RAM_MASK;
+
+    if (c.chcr & CHCR_FROM_RAM) {
+        transferToDevice(c, addr, count, backward);
+    } else {
+        transferFromDevice(c, addr, count, backward);
+    }
+
+    if (syncMode(ch) == SyncMode::Request) {
+        // Request mode leaves MADR pointing past the last block and BCR's block count at 0
+        c.madr = (c.madr + (backward ? -4 : 4) * count) & 0xFFFFFF;
+        c.bcr &= 0xFFFF;
+    }
+
+    return count;
+}
+
+uint32_t DMA::runLinkedList(int ch) {
+    Channel& c = channels[ch];
+    uint32_t addr = c.madr & RAM_MASK;
+    uint32_t cycles = 0;
+
+    // Linked lists only go RAM -> GPU
+    for (uint32_t packets = 0; packets < LINKED_LIST_LIMIT; packets++) {
+        uint32_t header;
+        std::memcpy(&header, ram + addr, sizeof(header));
+
+        uint32_t count = header >> 24;
+        if (count > 0) {
+            transferToDevice(c, (addr + 4) & RAM_MASK, count, false);
+        }
+        cycles += count + 1;
+
+        if (header & 0x800000) break;
+        addr = header & RAM_MASK;
+    }
+
+    c.madr = 0xFFFFFF;
+    return cycles;
+}
+
+uint32_t DMA::runOTC(int ch) {
+    Channel& c = channels[ch];
+
+    uint32_t count = c.bcr & 0xFFFF;
+    if (count == 0) count = 0x10000;
+
+    // Build the empty ordering table: each entry points to the previous word,
+    // the last one written holds the end marker.
+    uint32_t* words = reinterpret_cast<uint32_t*>(ram);
+    uint32_t addr = c.madr & RAM_MASK;
+    for (uint32_t i = 0; i < count - 1; i++) {
+        uint32_t prev = (addr - 4) & RAM_MASK;
+        words[addr >> 2] = prev;
+        addr = prev;
+    }
+    words[addr >> 2] = 0xFFFFFF;
+
+    return count;
+}
+
+void DMA::transferToDevice(Channel& c, uint32_t addr, uint32_t count, bool backward) {
+    if (!c.port.toDevice) return;
+
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(ram);
+
+    if (!backward) {
+        // Hand the device direct pointers into RAM, splitting only at the 2MB wrap
+        while (count > 0) {
+            uint32_t run = std::min(count, (RAM_MASK + 4 - addr) >> 2);
+            c.port.toDevice(c.port.ctx, words + (addr >> 2), run);
+            addr = (addr + run * 4) & RAM_MASK;
+            count -= run;
+        }
+        return;
+    }
+
+    bounce.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        bounce[i] = words[addr >> 2];
+        addr = (addr - 4) & RAM_MASK;
+    }
+    c.port.toDevice(c.port.ctx, bounce.data(), count);
+}
+
+void DMA::transferFromDevice(Channel& c, uint32_t addr, uint32_t count, bool backward) {
+    if (!c.port.fromDevice) return;
+
+    uint32_t* words = reinterpret_cast<uint32_t*>(ram);
+
+    if (!backward) {
+        // Device writes land straight in the backing vector
+        while (count > 0) {
+            uint32_t run = std::min(count, (RAM_MASK + 4 - addr) >> 2);
+            c.port.fromDevice(c.port.ctx, words + (addr >> 2), run);
+            addr = (addr + run * 4) & RAM_MASK;
+            count -= run;
+        }
+        return;
+    }
+
+    bounce.resize(count);
+    c.port.fromDevice(c.port.ctx, bounce.data(), count);
+    for (uint32_t i = 0; i < count; i++) {
+        words[addr >> 2] = bounce[i];
+        addr = (addr - 4) & RAM_MASK;
+    }
+}
+
+void DMA::complete(int ch) {
+    channels[ch].chcr &= ~(CHCR_START | CHCR_TRIGGER);
+
+    if (dicr & (1u << (16 + ch))) {
+        dicr |= 1u << (24 + ch);
+    }
+    updateMasterFlag();
+}
+
+void DMA::updateMasterFlag() {
+    const bool was_set = (dicr >> 31) & 1;
+
+    const bool force = (dicr >> 15) & 1;
+    const bool master_enable = (dicr >> 23) & 1;
+    const uint32_t enables = (dicr >> 16) & 0x7F;
+    const uint32_t flags = (dicr >> 24) & 0x7F;
+
+    const bool now_set = force || (master_enable && (enables & flags));
+
+    dicr = (dicr & 0x7FFFFFFF) | (static_cast<uint32_t>(now_set) << 31);
+
+    if (!was_set && now_set) {
+        bus->interrupts.request(IRQ::DMA);
+    }
+}
@@ -0,0 +1,81 @@
+/*
+    Description: Frame-driven Run Loop Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+
+#include "gpu.hpp"
+
+class Bus;
+class CPU;
+class VideoOutput;
+class DigitalPad;
+
+enum class SpeedMode : uint8_t {
+    RealTime,       // Paced to the emulated frame rate, every frame presented
+    Uncapped,       // As fast as possible, nothing presented
+    FastForward     // Paced to N x real time, every Nth frame presented
+};
+
+// Runs the machine one video frame (VBlank to VBlank) at a time. Pacing follows
+// emulated time rather than a nominal refresh rate, so the video timing the GPU
+// is programmed for (NTSC or PAL, interlaced or not) is what the host sees, and
+// audio stays in step. Achieved FPS and host headroom (the share of the real-time
+// frame budget left unused) are reported once per second.
+class RunLoop {
+    public:
+        RunLoop(Bus* bus, CPU* cpu, GPU* gpu, VideoOutput* video);
+
+        // factor is only used by FastForward
+        void setMode(SpeedMode mode, unsigned factor = 1);
+
+        // Pad fed from the window's keyboard state once per frame
+        void connectPad(DigitalPad* device) { pad = device; }
+
+        // Stop after `frames` frames (0 = run until stopped), e.g. for batch test runs
+        void setFrameLimit(uint64_t frames) { frame_limit = frames; }
+
+        // Run until `stop` becomes non-zero, the window is closed, the frame limit is
+        // hit or the CPU stops at a breakpoint or watchpoint
+        void run(const volatile std::sig_atomic_t& stop);
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void runFrame();
+        void waitUntil(Clock::time_point deadline);
+        void report(Clock::time_point now, bool final);
+        bool presentFrame() const;
+
+        Bus* bus;
+        CPU* cpu;
+        GPU* gpu;
+        VideoOutput* video;
+        DigitalPad* pad = nullptr;
+        FrameSink video_sink;
+
+        SpeedMode mode = SpeedMode::RealTime;
+        unsigned factor = 1;
+        uint64_t frame_limit = 0;
+        uint64_t frames_run = 0;
+
+        // Pacing origin: host time at which emulated cycle `origin_cycles` is due
+        Clock::time_point origin;
+        uint64_t origin_cycles = 0;
+
+        // Statistics of the current report interval
+        Clock::time_point interval_start;
+        uint64_t interval_frames = 0;
+        uint64_t interval_cycles = 0;
+        Clock::duration interval_busy = {};
+
+        Clock::time_point run_start;
+        uint64_t run_start_cycles = 0;
+        Clock::duration run_busy = {};
+};
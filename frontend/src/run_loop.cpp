@@ -0,0 +1,148 @@
+/*
+    Description: Frame-driven Run Loop Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "run_loop.hpp"
+#include "bus.hpp"
+#include "cpu.hpp"
+#include "video_output.hpp"
+#include "controller.hpp"
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace {
+    constexpr double CPU_CLOCK = 33868800.0;
+
+    // OS sleeps overshoot by up to a scheduler tick: sleep to within this margin
+    // of the deadline, then spin the rest
+    constexpr auto SPIN_MARGIN = std::chrono::milliseconds(2);
+
+    // Further behind than this (a debugger stop, a slow host) and the pacing
+    // restarts from now instead of racing to catch up
+    constexpr auto MAX_LAG = std::chrono::milliseconds(100);
+
+    constexpr auto REPORT_INTERVAL = std::chrono::seconds(1);
+
+    double seconds(std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double>(d).count();
+    }
+}
+
+RunLoop::RunLoop(Bus* bus, CPU* cpu, GPU* gpu, VideoOutput* video)
+    : bus(bus), cpu(cpu), gpu(gpu), video(video) {
+    if (video && video->isOpen()) {
+        video_sink = video->sink();
+    }
+}
+
+void RunLoop::setMode(SpeedMode new_mode, unsigned new_factor) {
+    mode = new_mode;
+    factor = (mode == SpeedMode::FastForward && new_factor > 1) ? new_factor : 1;
+
+    // Pacing restarts from the current position at the new rate
+    origin = Clock::now();
+    origin_cycles = bus->scheduler.timestamp();
+}
+
+bool RunLoop::presentFrame() const {
+    switch (mode) {
+        case SpeedMode::RealTime: return true;
+        case SpeedMode::Uncapped: return false;
+        case SpeedMode::FastForward: return frames_run % factor == 0;
+    }
+    return true;
+}
+
+void RunLoop::run(const volatile std::sig_atomic_t& stop) {
+    run_start = interval_start = origin = Clock::now();
+    run_start_cycles = origin_cycles = bus->scheduler.timestamp();
+
+    while (stop == 0 && !(video && video->closeRequested())) {
+        if (frame_limit && frames_run >= frame_limit) break;
+        if (cpu->isHalted()) break;
+
+        const Clock::time_point begin = Clock::now();
+        const uint64_t begin_cycles = bus->scheduler.timestamp();
+        runFrame();
+        const Clock::time_point end = Clock::now();
+        const uint64_t cycles = bus->scheduler.timestamp() - begin_cycles;
+
+        interval_frames++;
+        interval_cycles += cycles;
+        interval_busy += end - begin;
+        run_busy += end - begin;
+
+        if (mode != SpeedMode::Uncapped) {
+            const double due = (bus->scheduler.timestamp() - origin_cycles) / (CPU_CLOCK * factor);
+            const Clock::time_point deadline = origin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(due));
+            if (end > deadline + MAX_LAG) {
+                origin = end;
+                origin_cycles = bus->scheduler.timestamp();
+            } else {
+                waitUntil(deadline);
+            }
+        }
+
+        const Clock::time_point now = Clock::now();
+        if (now - interval_start >= REPORT_INTERVAL) {
+            report(now, false);
+        }
+    }
+
+    report(Clock::now(), true);
+}
+
+void RunLoop::runFrame() {
+    // The sink is called at the VBlank that ends this frame
+    gpu->connectVideo(presentFrame() ? video_sink : FrameSink{});
+
+    const uint64_t frame = gpu->getFrameCount();
+    // A breakpoint or watchpoint hit ends the frame early
+    while (gpu->getFrameCount() == frame && !cpu->isHalted()) {
+        cpu->step();
+    }
+    frames_run++;
+
+    // The window must stay responsive even when frames are not presented
+    if (video) video->pollEvents();
+    if (video && pad) pad->setButtons(video->padButtons());
+}
+
+void RunLoop::waitUntil(Clock::time_point deadline) {
+    Clock::time_point now = Clock::now();
+    if (deadline - now > SPIN_MARGIN) {
+        std::this_thread::sleep_for(deadline - now - SPIN_MARGIN);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+// Headroom compares host time spent emulating with the emulated time it covered:
+// 75% means a frame costs a quarter of its real-time budget, negative means the
+// host cannot keep up with real time
+void RunLoop::report(Clock::time_point now, bool final) {
+    static const char* const names[] = {"real-time", "uncapped", "fast-forward"};
+
+    const double wall = seconds(now - (final ? run_start : interval_start));
+    const uint64_t frames = final ? frames_run : interval_frames;
+    const double emulated = (final ? bus->scheduler.timestamp() - run_start_cycles : interval_cycles) / CPU_CLOCK;
+    const double busy = seconds(final ? run_busy : interval_busy);
+
+    if (wall > 0 && emulated > 0) {
+        std::cout << std::fixed << std::setprecision(1)
+                  << "[Main] " << (final ? "Average " : "") << names[static_cast<int>(mode)];
+        if (mode == SpeedMode::FastForward) std::cout << " " << factor << "x";
+        std::cout << ": " << std::setprecision(2) << frames / wall << " fps, "
+                  << std::setprecision(1) << 100.0 * emulated / wall << "% speed, "
+                  << 100.0 * (1.0 - busy / emulated) << "% headroom" << std::endl;
+    }
+
+    interval_start = now;
+    interval_frames = 0;
+    interval_cycles = 0;
+    interval_busy = {};
+}
@@ -0,0 +1,72 @@
+/*
+    Description: Single-Producer / Single-Consumer Command Ring Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Lock-free word ring between the emulation thread (producer) and a device
+// worker thread (consumer): the GPU render thread or the SPU audio thread. Each
+// entry is a header word (tag << 24 | count) followed by `count` payload words.
+// The mutex/condvar pair is only touched when the consumer runs dry and goes to
+// sleep; the hot path is two atomics.
+class CommandRing {
+    public:
+        static constexpr uint32_t MAX_PAYLOAD = 0xFFFFFF;
+
+        explicit CommandRing(size_t capacity_words);
+        ~CommandRing();
+
+        // --- Producer side ---
+
+        // Blocks (spinning, then yielding) while the ring is full
+        void push(uint8_t tag, const uint32_t* words, uint32_t count);
+
+        // Wait until the consumer has processed every entry pushed so far
+        void drain() const;
+
+        bool empty() const {
+            return read_pos.load(std::memory_order_acquire) == write_pos.load(std::memory_order_acquire);
+        }
+
+        // --- Consumer side ---
+
+        struct Entry {
+            uint8_t tag;
+            const uint32_t* words;
+            uint32_t count;
+        };
+
+        // Sleeps until an entry is available or stop() is called. Returns false on stop.
+        bool wait();
+
+        // Peek the oldest entry. Payload stays valid until pop().
+        Entry front();
+        void pop();
+
+        void stop();
+
+    private:
+        size_t capacity;
+        size_t mask;
+        std::vector<uint32_t> buffer;
+
+        // Scratch copy for entries that straddle the end of the buffer
+        std::vector<uint32_t> wrap_scratch;
+
+        alignas(64) std::atomic<uint64_t> write_pos{0};
+        alignas(64) std::atomic<uint64_t> read_pos{0};
+        uint64_t front_size = 0;
+
+        alignas(64) std::atomic<bool> consumer_sleeping{false};
+        std::atomic<bool> stopping{false};
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+};
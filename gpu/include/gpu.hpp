@@ -0,0 +1,212 @@
+/*
+    Description: GPU (GP0/GP1 Command Processor) Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "command_ring.hpp"
+#include "dma.hpp"
+#include "rasterizer.hpp"
+#include "tile_binner.hpp"
+
+class Bus;
+class Timers;
+
+enum class VideoMode : uint8_t { NTSC = 0, PAL = 1 };
+
+// Region of VRAM scanned out to the TV
+struct DisplayArea {
+    uint16_t x, y;              // VRAM origin (halfwords)
+    uint16_t width, height;     // Output pixels
+    bool rgb24;
+    bool enabled;
+
+    bool operator==(const DisplayArea& o) const {
+        return x == o.x && y == o.y && width == o.width && height == o.height && rgb24 == o.rgb24 && enabled == o.enabled;
+    }
+    bool operator!=(const DisplayArea& o) const { return !(*this == o); }
+};
+
+// Consumer of finished frames, called on the emulation thread at every VBlank with
+// VRAM in a consistent state. A sink without a `present` callback drops frames.
+struct FrameSink {
+    void* ctx = nullptr;
+    void (*present)(void* ctx, const uint16_t* vram, const DisplayArea& area) = nullptr;
+};
+
+class GPU {
+    public:
+        GPU(Bus* bus);
+        ~GPU();
+
+        void init();
+
+        // Root counters 0/1 count dots and scanlines, which depend on the display mode
+        void connectTimers(Timers* device);
+
+        // Register interface (offset relative to 0x1F801810)
+        uint32_t read32(uint32_t offset);
+        void write32(uint32_t offset, uint32_t data);
+
+        void gp0(uint32_t word);
+        void gp1(uint32_t word);
+
+        // Move GP0 processing and rasterization onto a dedicated render thread.
+        // GP0 words are then queued; the emulation thread only waits in sync().
+        void setThreaded(bool enable);
+        bool isThreaded() const { return threaded; }
+
+        // Bin primitives into VRAM tiles and rasterize them on `count` threads
+        // (the render side plus count - 1 workers). 0 draws every primitive immediately.
+        void setTileThreads(unsigned count);
+
+        // Block until every queued GP0 command has been executed and rasterized.
+        // Only an atomic load and an empty check when nothing is pending.
+        void sync();
+
+        void connectVideo(const FrameSink& sink) { frame_sink = sink; }
+
+        // DMA channel 2 endpoint
+        DMAPort dmaPort();
+
+        // Only consistent after sync(); VBlank syncs on every frame boundary
+        const uint16_t* getVRAM() const { return vram.data(); }
+        VideoMode getVideoMode() const { return video_mode; }
+        DisplayArea getDisplayArea() const;
+        uint64_t getFrameCount() const { return frame_count; }
+
+    private:
+        static constexpr int VRAM_WIDTH = Raster::VRAM_WIDTH;
+        static constexpr int VRAM_HEIGHT = Raster::VRAM_HEIGHT;
+
+        enum class GP0Mode { Command, ImageLoad, Polyline };
+
+        // Ring entry tags
+        static constexpr uint8_t RING_GP0 = 0;
+        static constexpr uint8_t RING_RESET_FIFO = 1;
+        static constexpr uint8_t RING_RESET_FULL = 2;
+
+        // --- Emulation thread side ---
+        void submitGP0(const uint32_t* words, uint32_t count);
+        void submitReset(bool full);
+        void renderLoop();
+
+        // --- Render side (render thread when threaded) ---
+        void resetCommandState(bool full);
+        void publishDrawStat();
+        void gp0Block(const uint32_t* words, uint32_t count);
+        uint32_t gp0ImageData(const uint32_t* words, uint32_t count);
+        void executeCommand();
+        uint32_t commandLength(uint32_t cmd) const;
+
+        void drawPolygon();
+        void drawRectangle();
+        void drawLine();
+        void drawPolylineSegment(uint32_t word);
+        void copyVRAM();
+        void beginImageLoad();
+        void beginImageStore();
+        void setDrawMode(uint32_t word);
+
+        // Route primitives to the tile binner or straight to the rasterizer
+        void rasterTriangle(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                            const Raster::Vertex& v0, const Raster::Vertex& v1, const Raster::Vertex& v2);
+        void rasterRect(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                        const Raster::Vertex& origin, int32_t w, int32_t h);
+        void rasterLine(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                        const Raster::Vertex& v0, const Raster::Vertex& v1);
+        void flushTilesIfDirty(int32_t x, int32_t y, int32_t w, int32_t h);
+        void flushTiles();
+
+        Raster::DrawEnv drawEnv() const;
+        Raster::Vertex decodeVertex(uint32_t xy) const;
+
+        uint32_t readData();
+        // Next GPUREAD word without syncing; callers sync once per transfer
+        uint32_t readStoreWord();
+
+        // --- Timing ---
+        void scheduleVBlank();
+        void updateVideoClocks();
+        uint32_t cyclesPerFrame() const;
+
+        static void onVBlank(void* ctx, uint64_t now);
+        static void dmaToDevice(void* ctx, const uint32_t* words, uint32_t count);
+        static void dmaFromDevice(void* ctx, uint32_t* words, uint32_t count);
+
+        Bus* bus = nullptr;
+        Timers* timers = nullptr;
+
+        // 1024x512 16bpp, plus padding so 32-bit gathers at the last pixel stay in bounds
+        std::vector<uint16_t> vram;
+        Raster::Rasterizer rasterizer;
+        std::unique_ptr<TileBinner> binner;
+
+        bool threaded = false;
+        std::unique_ptr<CommandRing> ring;
+        std::thread render_thread;
+
+        // Command buffer
+        GP0Mode gp0_mode = GP0Mode::Command;
+        std::array<uint32_t, 16> fifo;
+        uint32_t fifo_len = 0;
+        uint32_t fifo_needed = 0;
+
+        // CPU <-> VRAM transfers
+        struct Transfer {
+            int32_t x, y, w, h;
+            int32_t cur_x, cur_y;
+            uint32_t remaining;     // Pixels left
+        };
+        Transfer load = {}, store = {};
+        std::atomic<bool> store_pending{false};
+        uint32_t gpuread = 0;
+
+        // Polyline state
+        uint32_t polyline_cmd = 0;
+        Raster::Vertex polyline_last = {};
+        bool polyline_expect_color = false;
+        uint32_t polyline_color = 0;
+
+        // Draw mode (E1)
+        uint16_t texpage = 0;
+        bool dither = false;
+        bool draw_to_display = false;
+        bool texture_disable = false;
+        bool rect_flip_x = false, rect_flip_y = false;
+
+        // E2-E6
+        uint8_t window_mask_x = 0, window_mask_y = 0, window_offset_x = 0, window_offset_y = 0;
+        int16_t area_x1 = 0, area_y1 = 0, area_x2 = 0, area_y2 = 0;
+        int16_t offset_x = 0, offset_y = 0;
+        bool set_mask = false, check_mask = false;
+
+        // GPUSTAT bits 0-12 and 15, published by the render side for lock-free GPUSTAT reads
+        std::atomic<uint32_t> draw_stat{0};
+
+        // Display control (GP1)
+        bool display_disable = true;
+        std::atomic<bool> irq{false};
+        uint32_t dma_direction = 0;
+        uint16_t display_x = 0, display_y = 0;
+        uint16_t hrange_x1 = 0x200, hrange_x2 = 0xC00;
+        uint16_t vrange_y1 = 0x10, vrange_y2 = 0x100;
+        uint8_t hres = 0;           // GPUSTAT bits 16-18
+        bool vres = false;
+        VideoMode video_mode = VideoMode::NTSC;
+        bool color_depth_24 = false;
+        bool interlaced = false;
+        bool odd_field = false;
+
+        uint64_t frame_count = 0;
+        FrameSink frame_sink;
+};
@@ -0,0 +1,94 @@
+/*
+    Description: Software Rasterizer Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Raster {
+
+    constexpr int VRAM_WIDTH = 1024;
+    constexpr int VRAM_HEIGHT = 512;
+
+    enum class SemiMode : uint8_t {
+        Average     = 0,    // B/2 + F/2
+        Add         = 1,    // B + F
+        Subtract    = 2,    // B - F
+        AddQuarter  = 3,    // B + F/4
+    };
+
+    enum class TextureDepth : uint8_t {
+        T4  = 0,
+        T8  = 1,
+        T15 = 2,
+    };
+
+    // Drawing environment latched from GP0 E1-E6 at the time a primitive is submitted.
+    // The clip rectangle is inclusive and already includes the drawing area.
+    struct DrawEnv {
+        int16_t clip_x1, clip_y1, clip_x2, clip_y2;
+        int16_t offset_x, offset_y;
+        uint8_t window_mask_x, window_mask_y;
+        uint8_t window_offset_x, window_offset_y;
+        bool dither;
+        bool set_mask;
+        bool check_mask;
+    };
+
+    // Per-primitive render attributes decoded from the GP0 command word
+    struct PrimAttrs {
+        bool textured;
+        bool gouraud;
+        bool semi;
+        bool raw;               // Texture without colour modulation
+        SemiMode semi_mode;
+        TextureDepth depth;
+        uint16_t texpage_x, texpage_y;
+        uint16_t clut_x, clut_y;
+    };
+
+    struct Vertex {
+        int32_t x, y;
+        uint8_t r, g, b;
+        uint8_t u, v;
+    };
+
+    // Decoders shared by the command processor and the tile binner
+    inline PrimAttrs decodeTexpage(PrimAttrs attrs, uint16_t texpage) {
+        attrs.texpage_x = (texpage & 0xF) * 64;
+        attrs.texpage_y = ((texpage >> 4) & 1) * 256;
+        attrs.semi_mode = static_cast<SemiMode>((texpage >> 5) & 3);
+        attrs.depth = static_cast<TextureDepth>(std::min<uint32_t>((texpage >> 7) & 3, 2));
+        return attrs;
+    }
+
+    inline void decodeClut(PrimAttrs& attrs, uint16_t clut) {
+        attrs.clut_x = (clut & 0x3F) * 16;
+        attrs.clut_y = (clut >> 6) & 0x1FF;
+    }
+
+    // Rasterizes into a 1024x512 16bpp VRAM. Stateless apart from the VRAM pointer,
+    // so several instances may draw into disjoint clip rectangles concurrently.
+    class Rasterizer {
+        public:
+            explicit Rasterizer(uint16_t* vram) : vram(vram) {}
+
+            void drawTriangle(const DrawEnv& env, const PrimAttrs& attrs, const Vertex& v0, const Vertex& v1, const Vertex& v2);
+            void drawRect(const DrawEnv& env, const PrimAttrs& attrs, const Vertex& origin, int32_t w, int32_t h, bool flip_x, bool flip_y);
+            void drawLine(const DrawEnv& env, const PrimAttrs& attrs, const Vertex& v0, const Vertex& v1);
+
+            // GP0(02h): ignores the drawing area, mask settings and offset
+            void fillRect(uint16_t color, int32_t x, int32_t y, int32_t w, int32_t h);
+
+            // Name of the span kernel compiled into this build (scalar / sse2 / avx2)
+            static const char* backend();
+
+        private:
+            uint16_t* vram;
+    };
+
+}
@@ -0,0 +1,96 @@
+/*
+    Description: Tile-Binned Parallel Rasterization Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rasterizer.hpp"
+
+// Defers primitives into 64x64 VRAM tiles and rasterizes the tiles in parallel.
+// Each tile replays its primitives in submission order with the clip rectangle
+// narrowed to the tile; since the rasterizer derives every pixel from plane
+// equations, the output is bit-identical to drawing the primitives directly.
+//
+// Tiles only stay independent while no primitive samples texels another tile
+// writes. The binner flushes before a primitive would read pending output or
+// overwrite texels a pending primitive samples, and draws primitives that
+// sample their own target immediately.
+class TileBinner {
+    public:
+        TileBinner(uint16_t* vram, unsigned worker_count);
+        ~TileBinner();
+
+        void addTriangle(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                         const Raster::Vertex& v0, const Raster::Vertex& v1, const Raster::Vertex& v2);
+        void addRect(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                     const Raster::Vertex& origin, int32_t w, int32_t h, bool flip_x, bool flip_y);
+        void addLine(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                     const Raster::Vertex& v0, const Raster::Vertex& v1);
+
+        // True if pending primitives write or sample inside the rectangle (wraps at the VRAM edges)
+        bool overlapsPending(int32_t x, int32_t y, int32_t w, int32_t h) const;
+
+        // Rasterize everything binned so far and wait for the workers
+        void flush();
+
+        bool empty() const { return prims.empty(); }
+
+    private:
+        static constexpr int TILE_SIZE = 64;
+        static constexpr int TILES_X = Raster::VRAM_WIDTH / TILE_SIZE;
+        static constexpr int TILES_Y = Raster::VRAM_HEIGHT / TILE_SIZE;
+        static constexpr int TILE_COUNT = TILES_X * TILES_Y;
+
+        // Flush automatically once this many primitives are queued
+        static constexpr size_t MAX_PRIMS = 16384;
+
+        using TileMask = std::bitset<TILE_COUNT>;
+
+        enum class Kind : uint8_t { Triangle, Rect, Line };
+
+        struct Prim {
+            Kind kind;
+            bool flip_x, flip_y;
+            Raster::DrawEnv env;
+            Raster::PrimAttrs attrs;
+            Raster::Vertex v[3];
+            int32_t w, h;
+        };
+
+        static TileMask tileMask(int32_t x, int32_t y, int32_t w, int32_t h);
+        static TileMask textureMask(const Raster::PrimAttrs& attrs);
+
+        void bin(const Prim& prim, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+        void draw(const Prim& prim, const Raster::DrawEnv& env);
+        void renderTile(int tile);
+        void runJobs();
+        void workerLoop();
+
+        Raster::Rasterizer rasterizer;
+
+        std::vector<Prim> prims;
+        std::array<std::vector<uint32_t>, TILE_COUNT> tiles;
+        TileMask dirty;         // Tiles written by pending primitives
+        TileMask sampled;       // Tiles read as texture/CLUT by pending primitives
+        std::vector<int> jobs;
+
+        // Worker pool
+        std::vector<std::thread> workers;
+        std::mutex pool_mutex;
+        std::condition_variable start_cv, done_cv;
+        uint64_t generation = 0;
+        unsigned busy_workers = 0;
+        bool quit = false;
+        std::atomic<size_t> next_job{0};
+};
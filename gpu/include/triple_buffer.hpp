@@ -0,0 +1,45 @@
+/*
+    Description: Lock-free Triple Buffer Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Index exchange between one producer and one consumer over three slots. The
+// producer always owns a back slot and the consumer a front slot; the third sits
+// in the middle. Publishing swaps back and middle, acquiring swaps middle and
+// front, so neither side ever waits and the consumer always gets the newest frame.
+// Frames published faster than they are acquired are dropped (overwritten).
+class TripleBuffer {
+    public:
+        static constexpr int SLOTS = 3;
+
+        // Producer side: slot to fill next, then hand it over
+        int back() const { return back_index; }
+        void publish() {
+            const uint8_t old = middle.exchange(static_cast<uint8_t>(back_index) | FRESH, std::memory_order_acq_rel);
+            back_index = old & INDEX_MASK;
+        }
+
+        // Consumer side: take the newest published slot; false when nothing new
+        // was published since the last acquire (front() is unchanged)
+        bool acquire() {
+            if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+            const uint8_t old = middle.exchange(static_cast<uint8_t>(front_index), std::memory_order_acq_rel);
+            front_index = old & INDEX_MASK;
+            return true;
+        }
+        int front() const { return front_index; }
+
+    private:
+        static constexpr uint8_t INDEX_MASK = 3;
+        static constexpr uint8_t FRESH = 4;
+
+        std::atomic<uint8_t> middle{1};
+        int back_index = 0;         // Producer only
+        int front_index = 2;        // Consumer only
+};
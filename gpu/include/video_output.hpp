@@ -0,0 +1,110 @@
+/*
+    Description: SDL Video Output Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gpu.hpp"
+#include "triple_buffer.hpp"
+
+struct SDL_Window;
+
+// Shows the display area in an SDL window. The emulation thread only diffs the
+// display area against the previous frame, converts the changed tiles to RGB and
+// publishes the frame through a triple buffer. A presenter thread owns the
+// renderer: it uploads just the changed tiles to a streaming texture and is the
+// only thread that ever waits on vsync.
+class VideoOutput {
+    public:
+        VideoOutput();
+        ~VideoOutput();
+
+        // Returns false when no display is available (headless runs keep the null sink)
+        bool open();
+        void close();
+
+        bool isOpen() const { return window != nullptr; }
+
+        // Producer endpoint for GPU::connectVideo
+        FrameSink sink();
+
+        // Handle window events; must run on the thread that opened the window, once per frame
+        void pollEvents();
+
+        // Controller buttons held on the keyboard (PadButton bits), updated by pollEvents
+        uint16_t padButtons() const { return pad_buttons; }
+
+        // Set once the window has been closed
+        bool closeRequested() const { return close_requested.load(std::memory_order_relaxed); }
+
+        // Frames published / frames the presenter actually showed
+        uint64_t getFramesPublished() const { return published.load(std::memory_order_relaxed); }
+        uint64_t getFramesPresented() const { return presented.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr int MAX_WIDTH = 640;
+        static constexpr int MAX_HEIGHT = 576;
+
+        // Dirty tracking granularity, in output pixels
+        static constexpr int TILE_W = 64;
+        static constexpr int TILE_H = 16;
+        static constexpr int TILE_COLS = MAX_WIDTH / TILE_W;
+        static constexpr int TILE_ROWS = MAX_HEIGHT / TILE_H;
+        static constexpr int TILE_COUNT = TILE_COLS * TILE_ROWS;
+        static constexpr int DIRTY_WORDS = (TILE_COUNT + 63) / 64;
+
+        using TileSet = std::bitset<TILE_COUNT>;
+
+        struct Frame {
+            std::vector<uint32_t> pixels;   // XRGB8888, MAX_WIDTH pitch
+            int width = 0;
+            int height = 0;
+        };
+
+        static void sinkPresent(void* ctx, const uint16_t* vram, const DisplayArea& area);
+
+        // --- Emulation thread ---
+        TileSet diffDisplayArea(const uint16_t* vram, const DisplayArea& area);
+        void convertTile(int tile, Frame& frame) const;
+        void publish(const TileSet& changed);
+
+        // --- Presenter thread ---
+        void presentLoop();
+        TileSet takeDirty();
+
+        SDL_Window* window = nullptr;
+        std::thread presenter;
+
+        TripleBuffer buffer;
+        std::array<Frame, TripleBuffer::SLOTS> frames;
+
+        // Emulation thread: last frame's display area and its 16bpp source, and the
+        // tiles each slot still has to catch up on
+        DisplayArea last_area = {};
+        std::vector<uint16_t> shadow;
+        std::array<TileSet, TripleBuffer::SLOTS> stale;
+
+        // Tiles changed since the presenter last uploaded
+        std::array<std::atomic<uint64_t>, DIRTY_WORDS> dirty;
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        bool frame_pending = false;
+        bool quit = false;
+
+        uint16_t pad_buttons = 0;
+        std::atomic<bool> close_requested{false};
+        std::atomic<uint64_t> published{0};
+        std::atomic<uint64_t> presented{0};
+};
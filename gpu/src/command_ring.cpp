@@ -0,0 +1,124 @@
+/*
+    Description: Single-Producer / Single-Consumer GPU Command Ring Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "command_ring.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace {
+    constexpr int SPIN_LIMIT = 256;
+
+    inline void backoff(int& spins) {
+        if (++spins > SPIN_LIMIT) std::this_thread::yield();
+    }
+}
+
+CommandRing::CommandRing(size_t capacity_words) {
+    // Round up to a power of two so positions can be masked
+    capacity = 1;
+    while (capacity < capacity_words) capacity <<= 1;
+    mask = capacity - 1;
+    buffer.resize(capacity);
+}
+
+CommandRing::~CommandRing() = default;
+
+void CommandRing::push(uint8_t tag, const uint32_t* words, uint32_t count) {
+    // Large blocks are split so a single entry never needs more than half the ring
+    const uint32_t max_chunk = static_cast<uint32_t>(std::min<size_t>(capacity / 2 - 1, MAX_PAYLOAD));
+    if (count > max_chunk) {
+        while (count > 0) {
+            uint32_t chunk = std::min(count, max_chunk);
+            push(tag, words, chunk);
+            words += chunk;
+            count -= chunk;
+        }
+        return;
+    }
+
+    const uint64_t needed = count + 1;
+    const uint64_t write = write_pos.load(std::memory_order_relaxed);
+
+    int spins = 0;
+    while (write + needed - read_pos.load(std::memory_order_acquire) > capacity) {
+        backoff(spins);
+    }
+
+    buffer[write & mask] = (static_cast<uint32_t>(tag) << 24) | count;
+
+    const size_t start = (write + 1) & mask;
+    const size_t first = std::min<size_t>(count, capacity - start);
+    if (count > 0) {
+        std::memcpy(&buffer[start], words, first * sizeof(uint32_t));
+        std::memcpy(&buffer[0], words + first, (count - first) * sizeof(uint32_t));
+    }
+
+    // Sequentially consistent against consumer_sleeping (see wait())
+    write_pos.store(write + needed, std::memory_order_seq_cst);
+
+    if (consumer_sleeping.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        wake.notify_one();
+    }
+}
+
+void CommandRing::drain() const {
+    const uint64_t target = write_pos.load(std::memory_order_relaxed);
+    int spins = 0;
+    while (read_pos.load(std::memory_order_acquire) < target) {
+        backoff(spins);
+    }
+}
+
+bool CommandRing::wait() {
+    for (int spins = 0; spins < SPIN_LIMIT; spins++) {
+        if (stopping.load(std::memory_order_acquire)) return false;
+        if (write_pos.load(std::memory_order_acquire) != read_pos.load(std::memory_order_relaxed)) return true;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    consumer_sleeping.store(true, std::memory_order_seq_cst);
+    wake.wait(lock, [this] {
+        return stopping.load(std::memory_order_acquire) ||
+               write_pos.load(std::memory_order_seq_cst) != read_pos.load(std::memory_order_relaxed);
+    });
+    consumer_sleeping.store(false, std::memory_order_relaxed);
+
+    return !stopping.load(std::memory_order_acquire);
+}
+
+CommandRing::Entry CommandRing::front() {
+    const uint64_t read = read_pos.load(std::memory_order_relaxed);
+    const uint32_t header = buffer[read & mask];
+
+    Entry entry;
+    entry.tag = static_cast<uint8_t>(header >> 24);
+    entry.count = header & MAX_PAYLOAD;
+    front_size = entry.count + 1;
+
+    const size_t start = (read + 1) & mask;
+    if (start + entry.count <= capacity) {
+        entry.words = &buffer[start];
+    } else {
+        const size_t first = capacity - start;
+        wrap_scratch.resize(entry.count);
+        std::memcpy(wrap_scratch.data(), &buffer[start], first * sizeof(uint32_t));
+        std::memcpy(wrap_scratch.data() + first, &buffer[0], (entry.count - first) * sizeof(uint32_t));
+        entry.words = wrap_scratch.data();
+    }
+    return entry;
+}
+
+void CommandRing::pop() {
+    read_pos.store(read_pos.load(std::memory_order_relaxed) + front_size, std::memory_order_release);
+}
+
+void CommandRing::stop() {
+    stopping.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    wake.notify_all();
+}
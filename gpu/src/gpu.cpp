@@ -0,0 +1,817 @@
+/*
+    Description: GPU (GP0/GP1 Command Processor) Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "gpu.hpp"
+#include "bus.hpp"
+#include "timers.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // Extra words after the 1024x512 VRAM for the SIMD texture gather
+    constexpr size_t VRAM_PADDING = 16;
+
+    constexpr int32_t signExtend11(uint32_t value) {
+        return static_cast<int32_t>(value << 21) >> 21;
+    }
+
+    // GPU clock (53.69 MHz) expressed against the CPU clock
+    constexpr uint64_t GPU_CLOCK_NUM = 11;
+    constexpr uint64_t GPU_CLOCK_DEN = 7;
+
+    constexpr uint32_t NTSC_LINES = 263, NTSC_CYCLES_PER_LINE = 3413;
+    constexpr uint32_t PAL_LINES = 314, PAL_CYCLES_PER_LINE = 3406;
+
+    // 4MB of queued GP0 words: several frames' worth of display lists
+    constexpr size_t RING_WORDS = 1 << 20;
+}
+
+GPU::GPU(Bus* bus)
+    : bus(bus),
+      vram(VRAM_WIDTH * VRAM_HEIGHT + VRAM_PADDING, 0),
+      rasterizer(vram.data()) {
+    init();
+}
+
+GPU::~GPU() {
+    setThreaded(false);
+}
+
+void GPU::init() {
+    std::fill(vram.begin(), vram.end(), 0);
+    gp1(0x00000000);
+
+    frame_count = 0;
+    odd_field = false;
+
+    if (!bus) return;
+
+    bus->scheduler.registerEvent(Event::VBlank, &GPU::onVBlank, this);
+    scheduleVBlank();
+}
+
+void GPU::connectTimers(Timers* device) {
+    timers = device;
+    updateVideoClocks();
+}
+
+DMAPort GPU::dmaPort() {
+    DMAPort port;
+    port.ctx = this;
+    port.toDevice = &GPU::dmaToDevice;
+    port.fromDevice = &GPU::dmaFromDevice;
+    return port;
+}
+
+void GPU::dmaToDevice(void* ctx, const uint32_t* words, uint32_t count) {
+    static_cast<GPU*>(ctx)->submitGP0(words, count);
+}
+
+void GPU::dmaFromDevice(void* ctx, uint32_t* words, uint32_t count) {
+    GPU* gpu = static_cast<GPU*>(ctx);
+    // One sync per transfer: the CPU cannot queue GP0 words while DMA runs
+    gpu->sync();
+    for (uint32_t i = 0; i < count; i++) {
+        words[i] = gpu->readStoreWord();
+    }
+}
+
+uint32_t GPU::read32(uint32_t offset) {
+    if ((offset & 4) == 0) {
+        return readData();
+    }
+
+    uint32_t stat = draw_stat.load(std::memory_order_relaxed);
+    stat |= static_cast<uint32_t>(!interlaced || odd_field) << 13;
+    stat |= static_cast<uint32_t>(hres) << 16;
+    stat |= static_cast<uint32_t>(vres) << 19;
+    stat |= static_cast<uint32_t>(video_mode) << 20;
+    stat |= static_cast<uint32_t>(color_depth_24) << 21;
+    stat |= static_cast<uint32_t>(interlaced) << 22;
+    stat |= static_cast<uint32_t>(display_disable) << 23;
+    stat |= static_cast<uint32_t>(irq) << 24;
+
+    // Queued commands never stall the CPU, so the threaded GPU always accepts more
+    const bool ready_cmd = threaded || (gp0_mode == GP0Mode::Command && fifo_len == 0);
+    const bool ready_vram = store_pending;
+    const bool ready_dma = true;
+
+    bool dma_request = false;
+    switch (dma_direction) {
+        case 1: dma_request = true; break;
+        case 2: dma_request = ready_dma; break;
+        case 3: dma_request = ready_vram; break;
+        default: break;
+    }
+
+    stat |= static_cast<uint32_t>(dma_request) << 25;
+    stat |= static_cast<uint32_t>(ready_cmd) << 26;
+    stat |= static_cast<uint32_t>(ready_vram) << 27;
+    stat |= static_cast<uint32_t>(ready_dma) << 28;
+    stat |= dma_direction << 29;
+    stat |= static_cast<uint32_t>(odd_field) << 31;
+    return stat;
+}
+
+void GPU::write32(uint32_t offset, uint32_t data) {
+    if ((offset & 4) == 0) {
+        gp0(data);
+    } else {
+        gp1(data);
+    }
+}
+
+// --- GP0 ---
+
+void GPU::gp0(uint32_t word) {
+    submitGP0(&word, 1);
+}
+
+void GPU::submitGP0(const uint32_t* words, uint32_t count) {
+    if (threaded) {
+        ring->push(RING_GP0, words, count);
+    } else {
+        gp0Block(words, count);
+    }
+}
+
+void GPU::submitReset(bool full) {
+    if (threaded) {
+        ring->push(full ? RING_RESET_FULL : RING_RESET_FIFO, nullptr, 0);
+    } else {
+        resetCommandState(full);
+    }
+}
+
+void GPU::resetCommandState(bool full) {
+    gp0_mode = GP0Mode::Command;
+    fifo_len = 0;
+    store_pending = false;
+
+    if (full) {
+        for (uint32_t e = 0xE1; e <= 0xE6; e++) {
+            uint32_t word = e << 24;
+            gp0Block(&word, 1);
+        }
+    }
+}
+
+void GPU::publishDrawStat() {
+    uint32_t stat = texpage & 0x1FF;
+    stat |= static_cast<uint32_t>(dither) << 9;
+    stat |= static_cast<uint32_t>(draw_to_display) << 10;
+    stat |= static_cast<uint32_t>(set_mask) << 11;
+    stat |= static_cast<uint32_t>(check_mask) << 12;
+    stat |= static_cast<uint32_t>(texture_disable) << 15;
+    draw_stat.store(stat, std::memory_order_relaxed);
+}
+
+void GPU::setThreaded(bool enable) {
+    if (enable == threaded) return;
+
+    if (enable) {
+        ring = std::make_unique<CommandRing>(RING_WORDS);
+        threaded = true;
+        render_thread = std::thread(&GPU::renderLoop, this);
+    } else {
+        ring->drain();
+        ring->stop();
+        render_thread.join();
+        threaded = false;
+        ring.reset();
+    }
+}
+
+void GPU::setTileThreads(unsigned count) {
+    // The render side is idle after sync() until the next ring push
+    sync();
+    binner.reset();
+    if (count > 0) {
+        binner = std::make_unique<TileBinner>(vram.data(), count - 1);
+    }
+}
+
+void GPU::sync() {
+    if (threaded) {
+        ring->drain();
+    }
+    // The render side is idle now, so pending tiles are flushed on this thread
+    flushTiles();
+}
+
+void GPU::renderLoop() {
+    while (ring->wait()) {
+        CommandRing::Entry entry = ring->front();
+        switch (entry.tag) {
+            case RING_GP0:        gp0Block(entry.words, entry.count); break;
+            case RING_RESET_FIFO: resetCommandState(false); break;
+            case RING_RESET_FULL: resetCommandState(true); break;
+            default: break;
+        }
+        ring->pop();
+    }
+}
+
+void GPU::gp0Block(const uint32_t* words, uint32_t count) {
+    while (count > 0) {
+        switch (gp0_mode) {
+            case GP0Mode::ImageLoad: {
+                uint32_t used = gp0ImageData(words, count);
+                words += used;
+                count -= used;
+                break;
+            }
+
+            case GP0Mode::Polyline:
+                drawPolylineSegment(*words++);
+                count--;
+                break;
+
+            case GP0Mode::Command: {
+                if (fifo_len == 0) {
+                    fifo_needed = commandLength(words[0] >> 24);
+                }
+                uint32_t take = std::min(count, fifo_needed - fifo_len);
+                std::copy(words, words + take, fifo.begin() + fifo_len);
+                fifo_len += take;
+                words += take;
+                count -= take;
+
+                if (fifo_len == fifo_needed) {
+                    executeCommand();
+                    fifo_len = 0;
+                }
+                break;
+            }
+        }
+    }
+}
+
+uint32_t GPU::commandLength(uint32_t cmd) const {
+    switch (cmd >> 5) {
+        case 1: {   // Polygon
+            uint32_t verts = (cmd & 0x08) ? 4 : 3;
+            uint32_t per_vertex = 1 + ((cmd & 0x04) ? 1 : 0);
+            uint32_t colors = (cmd & 0x10) ? verts - 1 : 0;
+            return 1 + verts * per_vertex + colors;
+        }
+        case 2:     // Line (first segment of a polyline)
+            return (cmd & 0x10) ? 4 : 3;
+        case 3:     // Rectangle
+            return 2 + ((cmd & 0x04) ? 1 : 0) + (((cmd >> 3) & 3) == 0 ? 1 : 0);
+        case 4:     // VRAM -> VRAM
+            return 4;
+        case 5:     // CPU -> VRAM
+        case 6:     // VRAM -> CPU
+            return 3;
+        default:
+            return cmd == 0x02 ? 3 : 1;
+    }
+}
+
+void GPU::executeCommand() {
+    const uint32_t cmd = fifo[0] >> 24;
+
+    switch (cmd >> 5) {
+        case 1: drawPolygon(); return;
+        case 2: drawLine(); return;
+        case 3: drawRectangle(); return;
+        case 4: copyVRAM(); return;
+        case 5: beginImageLoad(); return;
+        case 6: beginImageStore(); return;
+        default: break;
+    }
+
+    switch (cmd) {
+        case 0x02: {
+            // Fill ignores drawing area and mask; x/w are in 16 pixel units
+            uint32_t c = fifo[0];
+            uint16_t color = ((c >> 3) & 0x1F) | (((c >> 11) & 0x1F) << 5) | (((c >> 19) & 0x1F) << 10);
+            int32_t x = fifo[1] & 0x3F0;
+            int32_t y = (fifo[1] >> 16) & 0x1FF;
+            int32_t w = ((fifo[2] & 0x3FF) + 0xF) & ~0xF;
+            int32_t h = (fifo[2] >> 16) & 0x1FF;
+            flushTilesIfDirty(x, y, w, h);
+            rasterizer.fillRect(color, x, y, w, h);
+            break;
+        }
+        case 0x1F:
+            irq = true;
+            bus->interrupts.request(IRQ::GPU);
+            break;
+        case 0xE1:
+            setDrawMode(fifo[0]);
+            publishDrawStat();
+            break;
+        case 0xE2:
+            window_mask_x = fifo[0] & 0x1F;
+            window_mask_y = (fifo[0] >> 5) & 0x1F;
+            window_offset_x = (fifo[0] >> 10) & 0x1F;
+            window_offset_y = (fifo[0] >> 15) & 0x1F;
+            break;
+        case 0xE3:
+            area_x1 = fifo[0] & 0x3FF;
+            area_y1 = (fifo[0] >> 10) & 0x1FF;
+            break;
+        case 0xE4:
+            area_x2 = fifo[0] & 0x3FF;
+            area_y2 = (fifo[0] >> 10) & 0x1FF;
+            break;
+        case 0xE5:
+            offset_x = static_cast<int16_t>(signExtend11(fifo[0] & 0x7FF));
+            offset_y = static_cast<int16_t>(signExtend11((fifo[0] >> 11) & 0x7FF));
+            break;
+        case 0xE6:
+            set_mask = fifo[0] & 1;
+            check_mask = (fifo[0] >> 1) & 1;
+            publishDrawStat();
+            break;
+        default:
+            // NOP, cache flush and unknown commands
+            break;
+    }
+}
+
+void GPU::setDrawMode(uint32_t word) {
+    texpage = word & 0x1FF;
+    dither = (word >> 9) & 1;
+    draw_to_display = (word >> 10) & 1;
+    texture_disable = (word >> 11) & 1;
+    rect_flip_x = (word >> 12) & 1;
+    rect_flip_y = (word >> 13) & 1;
+}
+
+Raster::DrawEnv GPU::drawEnv() const {
+    Raster::DrawEnv env;
+    env.clip_x1 = area_x1;
+    env.clip_y1 = area_y1;
+    env.clip_x2 = area_x2;
+    env.clip_y2 = area_y2;
+    env.offset_x = offset_x;
+    env.offset_y = offset_y;
+    env.window_mask_x = window_mask_x;
+    env.window_mask_y = window_mask_y;
+    env.window_offset_x = window_offset_x;
+    env.window_offset_y = window_offset_y;
+    env.dither = dither;
+    env.set_mask = set_mask;
+    env.check_mask = check_mask;
+    return env;
+}
+
+Raster::Vertex GPU::decodeVertex(uint32_t xy) const {
+    Raster::Vertex v = {};
+    v.x = signExtend11(xy & 0x7FF);
+    v.y = signExtend11((xy >> 16) & 0x7FF);
+    return v;
+}
+
+namespace {
+    void setColor(Raster::Vertex& v, uint32_t color) {
+        v.r = color & 0xFF;
+        v.g = (color >> 8) & 0xFF;
+        v.b = (color >> 16) & 0xFF;
+    }
+}
+
+void GPU::drawPolygon() {
+    const uint32_t cmd = fifo[0] >> 24;
+    const bool gouraud = cmd & 0x10;
+    const bool quad = cmd & 0x08;
+    const bool textured = cmd & 0x04;
+
+    Raster::PrimAttrs attrs = {};
+    attrs.textured = textured;
+    attrs.gouraud = gouraud;
+    attrs.semi = cmd & 0x02;
+    attrs.raw = textured && (cmd & 0x01);
+
+    Raster::Vertex v[4];
+    uint32_t color = fifo[0];
+    uint32_t idx = 1;
+    uint16_t clut = 0, page = texpage;
+
+    const int count = quad ? 4 : 3;
+    for (int i = 0; i < count; i++) {
+        if (gouraud && i > 0) color = fifo[idx++];
+        v[i] = decodeVertex(fifo[idx++]);
+        setColor(v[i], color);
+        if (textured) {
+            uint32_t uv = fifo[idx++];
+            v[i].u = uv & 0xFF;
+            v[i].v = (uv >> 8) & 0xFF;
+            if (i == 0) clut = uv >> 16;
+            if (i == 1) page = uv >> 16;
+        }
+    }
+
+    if (textured) {
+        // The polygon's texpage also updates the E1 state
+        texpage = (texpage & ~0x1FF) | (page & 0x1FF);
+        publishDrawStat();
+        Raster::decodeClut(attrs, clut);
+    }
+    attrs = Raster::decodeTexpage(attrs, texpage);
+
+    const Raster::DrawEnv env = drawEnv();
+    rasterTriangle(env, attrs, v[0], v[1], v[2]);
+    if (quad) {
+        rasterTriangle(env, attrs, v[1], v[2], v[3]);
+    }
+}
+
+void GPU::drawRectangle() {
+    const uint32_t cmd = fifo[0] >> 24;
+    const bool textured = cmd & 0x04;
+
+    Raster::PrimAttrs attrs = {};
+    attrs.textured = textured;
+    attrs.semi = cmd & 0x02;
+    attrs.raw = textured && (cmd & 0x01);
+    attrs = Raster::decodeTexpage(attrs, texpage);
+
+    Raster::Vertex origin = decodeVertex(fifo[1]);
+    setColor(origin, fifo[0]);
+
+    uint32_t idx = 2;
+    if (textured) {
+        uint32_t uv = fifo[idx++];
+        origin.u = uv & 0xFF;
+        origin.v = (uv >> 8) & 0xFF;
+        Raster::decodeClut(attrs, uv >> 16);
+    }
+
+    int32_t w, h;
+    switch ((cmd >> 3) & 3) {
+        case 0:
+            w = fifo[idx] & 0x3FF;
+            h = (fifo[idx] >> 16) & 0x1FF;
+            break;
+        case 1: w = h = 1; break;
+        case 2: w = h = 8; break;
+        default: w = h = 16; break;
+    }
+
+    rasterRect(drawEnv(), attrs, origin, w, h);
+}
+
+void GPU::drawLine() {
+    const uint32_t cmd = fifo[0] >> 24;
+    const bool gouraud = cmd & 0x10;
+
+    Raster::PrimAttrs attrs = {};
+    attrs.gouraud = gouraud;
+    attrs.semi = cmd & 0x02;
+    attrs = Raster::decodeTexpage(attrs, texpage);
+
+    Raster::Vertex v0 = decodeVertex(fifo[1]);
+    setColor(v0, fifo[0]);
+
+    Raster::Vertex v1;
+    if (gouraud) {
+        v1 = decodeVertex(fifo[3]);
+        setColor(v1, fifo[2]);
+    } else {
+        v1 = decodeVertex(fifo[2]);
+        setColor(v1, fifo[0]);
+    }
+
+    rasterLine(drawEnv(), attrs, v0, v1);
+
+    if (cmd & 0x08) {
+        gp0_mode = GP0Mode::Polyline;
+        polyline_cmd = fifo[0];
+        polyline_last = v1;
+        polyline_expect_color = gouraud;
+    }
+}
+
+void GPU::drawPolylineSegment(uint32_t word) {
+    if ((word & 0xF000F000) == 0x50005000) {
+        gp0_mode = GP0Mode::Command;
+        return;
+    }
+
+    const bool gouraud = (polyline_cmd >> 28) & 1;
+    if (polyline_expect_color) {
+        polyline_color = word;
+        polyline_expect_color = false;
+        return;
+    }
+
+    Raster::PrimAttrs attrs = {};
+    attrs.gouraud = gouraud;
+    attrs.semi = (polyline_cmd >> 25) & 1;
+    attrs = Raster::decodeTexpage(attrs, texpage);
+
+    Raster::Vertex v = decodeVertex(word);
+    setColor(v, gouraud ? polyline_color : polyline_cmd);
+
+    rasterLine(drawEnv(), attrs, polyline_last, v);
+    polyline_last = v;
+    polyline_expect_color = gouraud;
+}
+
+void GPU::rasterTriangle(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                         const Raster::Vertex& v0, const Raster::Vertex& v1, const Raster::Vertex& v2) {
+    if (binner) {
+        binner->addTriangle(env, attrs, v0, v1, v2);
+    } else {
+        rasterizer.drawTriangle(env, attrs, v0, v1, v2);
+    }
+}
+
+void GPU::rasterRect(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                     const Raster::Vertex& origin, int32_t w, int32_t h) {
+    if (binner) {
+        binner->addRect(env, attrs, origin, w, h, rect_flip_x, rect_flip_y);
+    } else {
+        rasterizer.drawRect(env, attrs, origin, w, h, rect_flip_x, rect_flip_y);
+    }
+}
+
+void GPU::rasterLine(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                     const Raster::Vertex& v0, const Raster::Vertex& v1) {
+    if (binner) {
+        binner->addLine(env, attrs, v0, v1);
+    } else {
+        rasterizer.drawLine(env, attrs, v0, v1);
+    }
+}
+
+void GPU::flushTilesIfDirty(int32_t x, int32_t y, int32_t w, int32_t h) {
+    if (binner && binner->overlapsPending(x, y, w, h)) {
+        binner->flush();
+    }
+}
+
+void GPU::flushTiles() {
+    if (binner) {
+        binner->flush();
+    }
+}
+
+void GPU::copyVRAM() {
+    const int32_t src_x = fifo[1] & 0x3FF, src_y = (fifo[1] >> 16) & 0x1FF;
+    const int32_t dst_x = fifo[2] & 0x3FF, dst_y = (fifo[2] >> 16) & 0x1FF;
+    const int32_t w = (((fifo[3] & 0x3FF) - 1) & 0x3FF) + 1;
+    const int32_t h = ((((fifo[3] >> 16) & 0x1FF) - 1) & 0x1FF) + 1;
+
+    flushTilesIfDirty(src_x, src_y, w, h);
+    flushTilesIfDirty(dst_x, dst_y, w, h);
+
+    const uint16_t mask_or = set_mask ? 0x8000 : 0;
+    std::vector<uint16_t> line(w);
+
+    for (int32_t row = 0; row < h; row++) {
+        const uint16_t* src = &vram[((src_y + row) & (VRAM_HEIGHT - 1)) * VRAM_WIDTH];
+        uint16_t* dst = &vram[((dst_y + row) & (VRAM_HEIGHT - 1)) * VRAM_WIDTH];
+
+        // Buffer the row so overlapping copies read the source before it is overwritten
+        for (int32_t col = 0; col < w; col++) {
+            line[col] = src[(src_x + col) & (VRAM_WIDTH - 1)];
+        }
+        for (int32_t col = 0; col < w; col++) {
+            uint16_t& out = dst[(dst_x + col) & (VRAM_WIDTH - 1)];
+            if (check_mask && (out & 0x8000)) continue;
+            out = line[col] | mask_or;
+        }
+    }
+}
+
+void GPU::beginImageLoad() {
+    load.x = fifo[1] & 0x3FF;
+    load.y = (fifo[1] >> 16) & 0x1FF;
+    load.w = (((fifo[2] & 0x3FF) - 1) & 0x3FF) + 1;
+    load.h = ((((fifo[2] >> 16) & 0x1FF) - 1) & 0x1FF) + 1;
+    load.cur_x = 0;
+    load.cur_y = 0;
+    load.remaining = load.w * load.h;
+
+    flushTilesIfDirty(load.x, load.y, load.w, load.h);
+    gp0_mode = GP0Mode::ImageLoad;
+}
+
+uint32_t GPU::gp0ImageData(const uint32_t* words, uint32_t count) {
+    // Treat the payload as a pixel stream and copy it a row segment at a time
+    const uint16_t* pixels = reinterpret_cast<const uint16_t*>(words);
+    const uint32_t available = count * 2;
+    const uint32_t take = std::min(available, load.remaining);
+    const bool plain = !check_mask && !set_mask;
+    const uint16_t mask_or = set_mask ? 0x8000 : 0;
+
+    uint32_t done = 0;
+    while (done < take) {
+        uint32_t run = std::min<uint32_t>(take - done, load.w - load.cur_x);
+        uint16_t* row = &vram[((load.y + load.cur_y) & (VRAM_HEIGHT - 1)) * VRAM_WIDTH];
+        int32_t x = (load.x + load.cur_x) & (VRAM_WIDTH - 1);
+
+        // Split at the right edge of VRAM
+        uint32_t first = std::min<uint32_t>(run, VRAM_WIDTH - x);
+        const uint16_t* src = pixels + done;
+
+        if (plain) {
+            std::memcpy(row + x, src, first * sizeof(uint16_t));
+            std::memcpy(row, src + first, (run - first) * sizeof(uint16_t));
+        } else {
+            for (uint32_t i = 0; i < run; i++) {
+                uint16_t& out = row[(x + i) & (VRAM_WIDTH - 1)];
+                if (check_mask && (out & 0x8000)) continue;
+                out = src[i] | mask_or;
+            }
+        }
+
+        done += run;
+        load.cur_x += run;
+        if (load.cur_x == load.w) {
+            load.cur_x = 0;
+            load.cur_y++;
+        }
+    }
+
+    load.remaining -= take;
+    if (load.remaining == 0) {
+        gp0_mode = GP0Mode::Command;
+        // An odd pixel count leaves a padding halfword in the last word
+        return (take + 1) / 2;
+    }
+    return count;
+}
+
+void GPU::beginImageStore() {
+    store.x = fifo[1] & 0x3FF;
+    store.y = (fifo[1] >> 16) & 0x1FF;
+    store.w = (((fifo[2] & 0x3FF) - 1) & 0x3FF) + 1;
+    store.h = ((((fifo[2] >> 16) & 0x1FF) - 1) & 0x1FF) + 1;
+    store.cur_x = 0;
+    store.cur_y = 0;
+    store.remaining = store.w * store.h;
+    store_pending = true;
+}
+
+uint32_t GPU::readData() {
+    // GPUREAD depends on every command queued before it
+    sync();
+    return readStoreWord();
+}
+
+uint32_t GPU::readStoreWord() {
+    if (!store_pending) {
+        return gpuread;
+    }
+
+    uint32_t word = 0;
+    for (int half = 0; half < 2 && store.remaining > 0; half++) {
+        int32_t x = (store.x + store.cur_x) & (VRAM_WIDTH - 1);
+        int32_t y = (store.y + store.cur_y) & (VRAM_HEIGHT - 1);
+        word |= static_cast<uint32_t>(vram[y * VRAM_WIDTH + x]) << (16 * half);
+
+        store.remaining--;
+        if (++store.cur_x == store.w) {
+            store.cur_x = 0;
+            store.cur_y++;
+        }
+    }
+
+    if (store.remaining == 0) {
+        store_pending = false;
+    }
+
+    gpuread = word;
+    return word;
+}
+
+// --- GP1 ---
+
+void GPU::gp1(uint32_t word) {
+    const uint32_t cmd = (word >> 24) & 0x3F;
+
+    switch (cmd) {
+        case 0x00:
+            submitReset(true);
+            gp1(0x02000000);
+            gp1(0x03000001);
+            gp1(0x04000000);
+            gp1(0x05000000);
+            gp1(0x06C00200);
+            gp1(0x07040010);
+            gp1(0x08000000);
+            break;
+        case 0x01:
+            submitReset(false);
+            break;
+        case 0x02:
+            irq = false;
+            break;
+        case 0x03:
+            display_disable = word & 1;
+            break;
+        case 0x04:
+            dma_direction = word & 3;
+            break;
+        case 0x05:
+            display_x = word & 0x3FE;
+            display_y = (word >> 10) & 0x1FF;
+            break;
+        case 0x06:
+            hrange_x1 = word & 0xFFF;
+            hrange_x2 = (word >> 12) & 0xFFF;
+            break;
+        case 0x07:
+            vrange_y1 = word & 0x3FF;
+            vrange_y2 = (word >> 10) & 0x3FF;
+            break;
+        case 0x08:
+            hres = static_cast<uint8_t>(((word & 3) << 1) | ((word >> 6) & 1));
+            vres = (word >> 2) & 1;
+            video_mode = static_cast<VideoMode>((word >> 3) & 1);
+            color_depth_24 = (word >> 4) & 1;
+            interlaced = (word >> 5) & 1;
+            updateVideoClocks();
+            break;
+        case 0x10: case 0x11: case 0x12: case 0x13:
+        case 0x14: case 0x15: case 0x16: case 0x17:
+        case 0x18: case 0x19: case 0x1A: case 0x1B:
+        case 0x1C: case 0x1D: case 0x1E: case 0x1F:
+            // Reports render-side state
+            sync();
+            switch (word & 7) {
+                case 2:
+                    gpuread = window_mask_x | (window_mask_y << 5) | (window_offset_x << 10) | (window_offset_y << 15);
+                    break;
+                case 3: gpuread = area_x1 | (area_y1 << 10); break;
+                case 4: gpuread = area_x2 | (area_y2 << 10); break;
+                case 5: gpuread = (offset_x & 0x7FF) | ((offset_y & 0x7FF) << 11); break;
+                case 7: gpuread = 2; break;    // GPU version
+                default: break;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// --- Timing ---
+
+uint32_t GPU::cyclesPerFrame() const {
+    const uint64_t gpu_cycles = (video_mode == VideoMode::PAL)
+        ? static_cast<uint64_t>(PAL_LINES) * PAL_CYCLES_PER_LINE
+        : static_cast<uint64_t>(NTSC_LINES) * NTSC_CYCLES_PER_LINE;
+    return static_cast<uint32_t>(gpu_cycles * GPU_CLOCK_DEN / GPU_CLOCK_NUM);
+}
+
+void GPU::updateVideoClocks() {
+    if (!timers) return;
+
+    uint32_t dot_divider;
+    if (hres & 1) {
+        dot_divider = 7;    // 368 pixels
+    } else {
+        static constexpr uint32_t dividers[4] = {10, 8, 5, 4};
+        dot_divider = dividers[hres >> 1];
+    }
+
+    timers->setVideoClocks(dot_divider, video_mode == VideoMode::PAL ? PAL_CYCLES_PER_LINE : NTSC_CYCLES_PER_LINE);
+}
+
+DisplayArea GPU::getDisplayArea() const {
+    static constexpr uint16_t widths[4] = {256, 320, 512, 640};
+
+    DisplayArea area;
+    area.x = display_x;
+    area.y = display_y;
+    area.width = (hres & 1) ? 368 : widths[hres >> 1];
+
+    // Scanlines of the vertical display range, doubled in 480i
+    const uint16_t max_lines = video_mode == VideoMode::PAL ? 288 : 240;
+    const uint16_t lines = vrange_y2 > vrange_y1 ? vrange_y2 - vrange_y1 : 0;
+    area.height = std::min(lines, max_lines) << (interlaced && vres ? 1 : 0);
+
+    area.rgb24 = color_depth_24;
+    area.enabled = !display_disable && area.height > 0;
+    return area;
+}
+
+void GPU::scheduleVBlank() {
+    bus->scheduler.schedule(Event::VBlank, cyclesPerFrame());
+}
+
+void GPU::onVBlank(void* ctx, uint64_t now) {
+    (void)now;
+    GPU* gpu = static_cast<GPU*>(ctx);
+
+    // Frame boundary: let the render thread catch up so VRAM holds a whole frame
+    gpu->sync();
+
+    if (gpu->frame_sink.present) {
+        gpu->frame_sink.present(gpu->frame_sink.ctx, gpu->vram.data(), gpu->getDisplayArea());
+    }
+
+    gpu->frame_count++;
+    gpu->odd_field = !gpu->odd_field;
+    gpu->bus->interrupts.request(IRQ::VBlank);
+    gpu->scheduleVBlank();
+}
@@ -0,0 +1,669 @@
+/*
+    Description: Software Rasterizer Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "rasterizer.hpp"
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RASTER_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define RASTER_SSE2 1
+#endif
+
+namespace Raster {
+
+namespace {
+
+    // Attributes are interpolated as 20.12 fixed point
+    constexpr int FRAC_BITS = 12;
+    constexpr int32_t HALF = 1 << (FRAC_BITS - 1);
+
+    // Spans are shaded 8 pixels at a time. The kernel below is written once against
+    // these lane types; the scalar build uses plain arrays so every backend produces
+    // bit-identical output.
+    constexpr int LANES = 8;
+
+    // Every texel and CLUT address is wrapped into VRAM before it is gathered;
+    // debug builds check that on each gather
+    inline void checkGather(const int32_t* idx) {
+#ifdef DEBUG
+        for (int i = 0; i < LANES; i++) assert(idx[i] >= 0 && idx[i] < VRAM_WIDTH * VRAM_HEIGHT);
+#endif
+        (void)idx;
+    }
+
+#if defined(RASTER_AVX2) || defined(RASTER_SSE2)
+
+    struct V16 { __m128i v; };
+
+    inline V16 set1(int16_t x) { return {_mm_set1_epi16(x)}; }
+    inline V16 load(const uint16_t* p) { return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))}; }
+    inline void store(uint16_t* p, V16 a) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a.v); }
+    inline V16 operator+(V16 a, V16 b) { return {_mm_add_epi16(a.v, b.v)}; }
+    inline V16 operator-(V16 a, V16 b) { return {_mm_sub_epi16(a.v, b.v)}; }
+    inline V16 operator*(V16 a, V16 b) { return {_mm_mullo_epi16(a.v, b.v)}; }
+    inline V16 operator&(V16 a, V16 b) { return {_mm_and_si128(a.v, b.v)}; }
+    inline V16 operator|(V16 a, V16 b) { return {_mm_or_si128(a.v, b.v)}; }
+    inline V16 andnot(V16 a, V16 b) { return {_mm_andnot_si128(a.v, b.v)}; }   // ~a & b
+    inline V16 srli(V16 a, int n) { return {_mm_srli_epi16(a.v, n)}; }
+    inline V16 srai(V16 a, int n) { return {_mm_srai_epi16(a.v, n)}; }
+    inline V16 slli(V16 a, int n) { return {_mm_slli_epi16(a.v, n)}; }
+    inline V16 min(V16 a, V16 b) { return {_mm_min_epi16(a.v, b.v)}; }
+    inline V16 max(V16 a, V16 b) { return {_mm_max_epi16(a.v, b.v)}; }
+    inline V16 cmpeq(V16 a, V16 b) { return {_mm_cmpeq_epi16(a.v, b.v)}; }
+    inline V16 cmpgt(V16 a, V16 b) { return {_mm_cmpgt_epi16(a.v, b.v)}; }
+
+#else
+
+    struct V16 { int16_t v[LANES]; };
+
+    template <typename F>
+    inline V16 map(V16 a, V16 b, F f) {
+        V16 r;
+        for (int i = 0; i < LANES; i++) r.v[i] = static_cast<int16_t>(f(a.v[i], b.v[i]));
+        return r;
+    }
+
+    inline V16 set1(int16_t x) { V16 r; for (auto& e : r.v) e = x; return r; }
+    inline V16 load(const uint16_t* p) { V16 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    inline void store(uint16_t* p, V16 a) { std::memcpy(p, a.v, sizeof(a.v)); }
+    inline V16 operator+(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x + y; }); }
+    inline V16 operator-(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x - y; }); }
+    inline V16 operator*(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x * y; }); }
+    inline V16 operator&(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x & y; }); }
+    inline V16 operator|(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x | y; }); }
+    inline V16 andnot(V16 a, V16 b) { return map(a, b, [](int x, int y) { return ~x & y; }); }
+    inline V16 srli(V16 a, int n) { return map(a, a, [n](int x, int) { return static_cast<uint16_t>(x) >> n; }); }
+    inline V16 srai(V16 a, int n) { return map(a, a, [n](int x, int) { return x >> n; }); }
+    inline V16 slli(V16 a, int n) { return map(a, a, [n](int x, int) { return x << n; }); }
+    inline V16 min(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x < y ? x : y; }); }
+    inline V16 max(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x > y ? x : y; }); }
+    inline V16 cmpeq(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x == y ? -1 : 0; }); }
+    inline V16 cmpgt(V16 a, V16 b) { return map(a, b, [](int x, int y) { return x > y ? -1 : 0; }); }
+
+#endif
+
+    // 8 x int32 lanes: interpolators and VRAM addresses
+#if defined(RASTER_AVX2)
+
+    struct V32 { __m256i v; };
+
+    inline V32 set1_32(int32_t x) { return {_mm256_set1_epi32(x)}; }
+    inline V32 load32(const int32_t* p) { return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))}; }
+    inline V32 operator+(V32 a, V32 b) { return {_mm256_add_epi32(a.v, b.v)}; }
+    inline V32 slli32(V32 a, int n) { return {_mm256_slli_epi32(a.v, n)}; }
+
+    // Integer part of a fixed point interpolator, saturated into 16 bit lanes
+    inline V16 integer(V32 a) {
+        __m256i s = _mm256_srai_epi32(a.v, FRAC_BITS);
+        __m256i p = _mm256_packs_epi32(s, s);
+        return {_mm256_castsi256_si128(_mm256_permute4x64_epi64(p, 0x08))};
+    }
+
+    inline V32 widen(V16 a) { return {_mm256_cvtepu16_epi32(a.v)}; }
+
+    inline V16 gather(const uint16_t* base, V32 index) {
+#ifdef DEBUG
+        alignas(32) int32_t idx[LANES];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(idx), index.v);
+        checkGather(idx);
+#endif
+        // VRAM carries a few words of padding so the 32-bit gather at the last word stays in bounds
+        __m256i g = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), index.v, 2);
+        g = _mm256_and_si256(g, _mm256_set1_epi32(0xFFFF));
+        __m256i p = _mm256_packus_epi32(g, g);
+        return {_mm256_castsi256_si128(_mm256_permute4x64_epi64(p, 0x08))};
+    }
+
+#elif defined(RASTER_SSE2)
+
+    struct V32 { __m128i lo, hi; };
+
+    inline V32 set1_32(int32_t x) { return {_mm_set1_epi32(x), _mm_set1_epi32(x)}; }
+    inline V32 load32(const int32_t* p) {
+        return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 4))};
+    }
+    inline V32 operator+(V32 a, V32 b) { return {_mm_add_epi32(a.lo, b.lo), _mm_add_epi32(a.hi, b.hi)}; }
+    inline V32 slli32(V32 a, int n) { return {_mm_slli_epi32(a.lo, n), _mm_slli_epi32(a.hi, n)}; }
+
+    inline V16 integer(V32 a) {
+        return {_mm_packs_epi32(_mm_srai_epi32(a.lo, FRAC_BITS), _mm_srai_epi32(a.hi, FRAC_BITS))};
+    }
+
+    inline V32 widen(V16 a) {
+        __m128i zero = _mm_setzero_si128();
+        return {_mm_unpacklo_epi16(a.v, zero), _mm_unpackhi_epi16(a.v, zero)};
+    }
+
+    inline V16 gather(const uint16_t* base, V32 index) {
+        alignas(16) int32_t idx[LANES];
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), index.lo);
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx + 4), index.hi);
+        checkGather(idx);
+        return {_mm_setr_epi16(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]],
+                               base[idx[4]], base[idx[5]], base[idx[6]], base[idx[7]])};
+    }
+
+#else
+
+    struct V32 { int32_t v[LANES]; };
+
+    inline V32 set1_32(int32_t x) { V32 r; for (auto& e : r.v) e = x; return r; }
+    inline V32 load32(const int32_t* p) { V32 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    inline V32 operator+(V32 a, V32 b) { V32 r; for (int i = 0; i < LANES; i++) r.v[i] = a.v[i] + b.v[i]; return r; }
+    inline V32 slli32(V32 a, int n) { V32 r; for (int i = 0; i < LANES; i++) r.v[i] = a.v[i] << n; return r; }
+
+    inline V16 integer(V32 a) {
+        V16 r;
+        for (int i = 0; i < LANES; i++) {
+            int32_t x = a.v[i] >> FRAC_BITS;
+            r.v[i] = static_cast<int16_t>(x < -32768 ? -32768 : (x > 32767 ? 32767 : x));
+        }
+        return r;
+    }
+
+    inline V32 widen(V16 a) { V32 r; for (int i = 0; i < LANES; i++) r.v[i] = static_cast<uint16_t>(a.v[i]); return r; }
+
+    inline V16 gather(const uint16_t* base, V32 index) {
+        checkGather(index.v);
+        V16 r;
+        for (int i = 0; i < LANES; i++) r.v[i] = static_cast<int16_t>(base[index.v[i]]);
+        return r;
+    }
+
+#endif
+
+    inline V16 select(V16 mask, V16 a, V16 b) { return (mask & a) | andnot(mask, b); }
+
+    // Interpolator for one attribute: value at the first lane plus a per-lane ramp
+    struct Ramp {
+        V32 cur;
+        V32 step;
+
+        Ramp(int32_t base, int32_t d) {
+            alignas(32) int32_t lanes[LANES];
+            for (int i = 0; i < LANES; i++) lanes[i] = base + d * i;
+            cur = load32(lanes);
+            step = set1_32(d * LANES);
+        }
+
+        V16 next() {
+            V16 r = integer(cur);
+            cur = cur + step;
+            return r;
+        }
+    };
+
+    // 4x4 ordered dither matrix, pre-rotated so lane 0 lines up with x & 3
+    struct DitherTable {
+        int16_t lanes[4][4][LANES];
+
+        DitherTable() {
+            static constexpr int8_t matrix[4][4] = {
+                {-4,  0, -3,  1},
+                { 2, -2,  3, -1},
+                {-3,  1, -4,  0},
+                { 3, -1,  2, -2},
+            };
+            for (int y = 0; y < 4; y++)
+                for (int x = 0; x < 4; x++)
+                    for (int i = 0; i < LANES; i++)
+                        lanes[y][x][i] = matrix[y][(x + i) & 3];
+        }
+    };
+
+    const DitherTable dither_table;
+
+    alignas(16) const uint16_t LANE_INDEX[LANES] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    enum class TexMode { None, T4, T8, T15 };
+
+    // Everything that stays constant across the spans of one primitive
+    struct SpanSetup {
+        uint16_t* vram;
+        bool gouraud;
+        bool raw;
+        bool semi;
+        bool dither;
+        bool set_mask;
+        bool check_mask;
+        SemiMode semi_mode;
+
+        int16_t r, g, b;    // Flat colour
+
+        int16_t texpage_x, texpage_y;
+        int32_t clut_row;   // First word of the CLUT's VRAM row
+        int16_t clut_x;
+        int16_t u_and, u_or, v_and, v_or;   // Texture window
+
+        int32_t drdx, dgdx, dbdx, dudx, dvdx;
+    };
+
+    struct Span {
+        int32_t x, y, count;
+        int32_t r, g, b, u, v;  // Fixed point at x, rounding bias included
+    };
+
+    template <TexMode TM>
+    V16 fetchTexel(const SpanSetup& s, V16 u, V16 v) {
+        u = (u & set1(s.u_and)) | set1(s.u_or);
+        v = (v & set1(s.v_and)) | set1(s.v_or);
+
+        V16 row = (v + set1(s.texpage_y)) & set1(VRAM_HEIGHT - 1);
+        V32 row_base = slli32(widen(row), 10);
+
+        if (TM == TexMode::T15) {
+            V16 col = (u + set1(s.texpage_x)) & set1(VRAM_WIDTH - 1);
+            return gather(s.vram, row_base + widen(col));
+        }
+
+        const V16 one = set1(1);
+        V16 index;
+
+        if (TM == TexMode::T8) {
+            V16 col = (srli(u, 1) + set1(s.texpage_x)) & set1(VRAM_WIDTH - 1);
+            V16 word = gather(s.vram, row_base + widen(col));
+            V16 odd = cmpeq(u & one, one);
+            index = select(odd, srli(word, 8), word) & set1(0xFF);
+        } else {
+            V16 col = (srli(u, 2) + set1(s.texpage_x)) & set1(VRAM_WIDTH - 1);
+            V16 word = gather(s.vram, row_base + widen(col));
+            const V16 two = set1(2);
+            V16 hi_byte = cmpeq(u & two, two);
+            word = select(hi_byte, srli(word, 8), word);
+            V16 hi_nibble = cmpeq(u & one, one);
+            index = select(hi_nibble, srli(word, 4), word) & set1(0xF);
+        }
+
+        // The palette wraps within its VRAM row: an 8bpp CLUT at x=1008 reaches x=1263
+        V16 clut_col = (index + set1(s.clut_x)) & set1(VRAM_WIDTH - 1);
+        return gather(s.vram, set1_32(s.clut_row) + widen(clut_col));
+    }
+
+    template <TexMode TM>
+    void drawSpan(const SpanSetup& s, const Span& span) {
+        const V16 lane_index = load(LANE_INDEX);
+
+        constexpr bool textured = TM != TexMode::None;
+
+        Ramp rr(span.r, s.drdx), gr(span.g, s.dgdx), br(span.b, s.dbdx);
+        Ramp ur(span.u, s.dudx), vr(span.v, s.dvdx);
+
+        const V16 c0 = set1(0), c31 = set1(31), c255 = set1(255);
+        const V16 mask_bit = set1(static_cast<int16_t>(0x8000));
+        const V16 set_mask = s.set_mask ? mask_bit : c0;
+
+        uint16_t* row = s.vram + span.y * VRAM_WIDTH;
+
+        for (int32_t i = 0; i < span.count; i += LANES) {
+            const int32_t x = span.x + i;
+            const int32_t n = std::min(LANES, span.count - i);
+            uint16_t* dst = row + x;
+
+            V16 valid = cmpgt(set1(static_cast<int16_t>(n)), lane_index);
+
+            // Background: full blocks load directly, the tail goes through a bounce buffer
+            // so nothing outside the span (or past the end of VRAM) is touched.
+            alignas(16) uint16_t tail[LANES] = {};
+            V16 bg;
+            if (n == LANES) {
+                bg = load(dst);
+            } else {
+                std::memcpy(tail, dst, n * sizeof(uint16_t));
+                bg = load(tail);
+            }
+
+            V16 r, g, b;
+            if (s.gouraud) {
+                r = max(min(rr.next(), c255), c0);
+                g = max(min(gr.next(), c255), c0);
+                b = max(min(br.next(), c255), c0);
+            } else {
+                r = set1(s.r); g = set1(s.g); b = set1(s.b);
+            }
+
+            V16 texel = c0;
+            if (textured) {
+                texel = fetchTexel<TM>(s, ur.next() & c255, vr.next() & c255);
+                valid = andnot(cmpeq(texel, c0), valid);
+
+                V16 tr = texel & c31;
+                V16 tg = srli(texel, 5) & c31;
+                V16 tb = srli(texel, 10) & c31;
+
+                if (s.raw) {
+                    r = slli(tr, 3); g = slli(tg, 3); b = slli(tb, 3);
+                } else {
+                    // (texel5 << 3) * colour / 128
+                    r = srli(tr * r, 4); g = srli(tg * g, 4); b = srli(tb * b, 4);
+                }
+            }
+
+            if (s.dither) {
+                V16 d = load(reinterpret_cast<const uint16_t*>(dither_table.lanes[span.y & 3][x & 3]));
+                r = r + d; g = g + d; b = b + d;
+            }
+
+            r = srli(max(min(r, c255), c0), 3);
+            g = srli(max(min(g, c255), c0), 3);
+            b = srli(max(min(b, c255), c0), 3);
+
+            if (s.semi) {
+                V16 bg_r = bg & c31;
+                V16 bg_g = srli(bg, 5) & c31;
+                V16 bg_b = srli(bg, 10) & c31;
+
+                V16 sr, sg, sb;
+                switch (s.semi_mode) {
+                    case SemiMode::Average:
+                        sr = srli(bg_r + r, 1); sg = srli(bg_g + g, 1); sb = srli(bg_b + b, 1);
+                        break;
+                    case SemiMode::Add:
+                        sr = min(bg_r + r, c31); sg = min(bg_g + g, c31); sb = min(bg_b + b, c31);
+                        break;
+                    case SemiMode::Subtract:
+                        sr = max(bg_r - r, c0); sg = max(bg_g - g, c0); sb = max(bg_b - b, c0);
+                        break;
+                    case SemiMode::AddQuarter:
+                    default:
+                        sr = min(bg_r + srli(r, 2), c31); sg = min(bg_g + srli(g, 2), c31); sb = min(bg_b + srli(b, 2), c31);
+                        break;
+                }
+
+                // Textured primitives are only blended where the texel's STP bit is set
+                V16 blend = textured ? srai(texel, 15) : set1(-1);
+                r = select(blend, sr, r);
+                g = select(blend, sg, g);
+                b = select(blend, sb, b);
+            }
+
+            if (s.check_mask) {
+                valid = andnot(srai(bg, 15), valid);
+            }
+
+            V16 out = r | slli(g, 5) | slli(b, 10) | set_mask;
+            if (textured) out = out | (texel & mask_bit);
+
+            out = select(valid, out, bg);
+
+            if (n == LANES) {
+                store(dst, out);
+            } else {
+                store(tail, out);
+                std::memcpy(dst, tail, n * sizeof(uint16_t));
+            }
+        }
+    }
+
+    void dispatchSpan(TexMode mode, const SpanSetup& s, const Span& span) {
+        switch (mode) {
+            case TexMode::None: drawSpan<TexMode::None>(s, span); break;
+            case TexMode::T4:   drawSpan<TexMode::T4>(s, span); break;
+            case TexMode::T8:   drawSpan<TexMode::T8>(s, span); break;
+            case TexMode::T15:  drawSpan<TexMode::T15>(s, span); break;
+        }
+    }
+
+    TexMode texMode(const PrimAttrs& attrs) {
+        if (!attrs.textured) return TexMode::None;
+        switch (attrs.depth) {
+            case TextureDepth::T4: return TexMode::T4;
+            case TextureDepth::T8: return TexMode::T8;
+            default:               return TexMode::T15;
+        }
+    }
+
+    SpanSetup makeSetup(uint16_t* vram, const DrawEnv& env, const PrimAttrs& attrs, const Vertex& v0) {
+        SpanSetup s = {};
+        s.vram = vram;
+        s.gouraud = attrs.gouraud;
+        s.raw = attrs.raw;
+        s.semi = attrs.semi;
+        s.set_mask = env.set_mask;
+        s.check_mask = env.check_mask;
+        s.semi_mode = attrs.semi_mode;
+        s.r = v0.r; s.g = v0.g; s.b = v0.b;
+
+        // Dithering only applies to shaded or modulated output
+        s.dither = env.dither && (attrs.gouraud || (attrs.textured && !attrs.raw));
+
+        s.texpage_x = attrs.texpage_x;
+        s.texpage_y = attrs.texpage_y;
+        s.clut_row = attrs.clut_y * VRAM_WIDTH;
+        s.clut_x = static_cast<int16_t>(attrs.clut_x);
+
+        s.u_and = static_cast<int16_t>(~(env.window_mask_x * 8) & 0xFF);
+        s.u_or = static_cast<int16_t>((env.window_offset_x & env.window_mask_x) * 8);
+        s.v_and = static_cast<int16_t>(~(env.window_mask_y * 8) & 0xFF);
+        s.v_or = static_cast<int16_t>((env.window_offset_y & env.window_mask_y) * 8);
+        return s;
+    }
+
+    int64_t floorDiv(int64_t a, int64_t b) {
+        int64_t q = a / b;
+        return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+    }
+
+    int64_t ceilDiv(int64_t a, int64_t b) {
+        return -floorDiv(-a, b);
+    }
+
+    // Plane equation of one attribute over the triangle, in fixed point per pixel
+    struct Gradient {
+        int64_t dx, dy;
+    };
+
+    Gradient gradient(int32_t a0, int32_t a1, int32_t a2, const Vertex& v0, const Vertex& v1, const Vertex& v2, int64_t area) {
+        int64_t da1 = a1 - a0, da2 = a2 - a0;
+        int64_t dx = (da1 * (v2.y - v0.y) - da2 * (v1.y - v0.y)) * (1 << FRAC_BITS);
+        int64_t dy = (da2 * (v1.x - v0.x) - da1 * (v2.x - v0.x)) * (1 << FRAC_BITS);
+        return {dx / area, dy / area};
+    }
+
+}
+
+const char* Rasterizer::backend() {
+#if defined(RASTER_AVX2)
+    return "avx2";
+#elif defined(RASTER_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void Rasterizer::drawTriangle(const DrawEnv& env, const PrimAttrs& attrs, const Vertex& a, const Vertex& b, const Vertex& c) {
+    Vertex v[3] = {a, b, c};
+    for (auto& vert : v) {
+        vert.x += env.offset_x;
+        vert.y += env.offset_y;
+    }
+
+    const int32_t min_x = std::min({v[0].x, v[1].x, v[2].x});
+    const int32_t max_x = std::max({v[0].x, v[1].x, v[2].x});
+    const int32_t min_y = std::min({v[0].y, v[1].y, v[2].y});
+    const int32_t max_y = std::max({v[0].y, v[1].y, v[2].y});
+
+    // The GPU drops polygons that span more than 1023x511 pixels
+    if (max_x - min_x >= VRAM_WIDTH || max_y - min_y >= VRAM_HEIGHT) return;
+
+    int64_t area = static_cast<int64_t>(v[1].x - v[0].x) * (v[2].y - v[0].y) -
+                   static_cast<int64_t>(v[2].x - v[0].x) * (v[1].y - v[0].y);
+    if (area == 0) return;
+    if (area < 0) {
+        std::swap(v[1], v[2]);
+        area = -area;
+    }
+
+    // Edge functions E(x, y) = A*x + B*y + C, positive inside. Pixels on top/left
+    // edges are drawn, pixels on bottom/right edges belong to the neighbour.
+    struct Edge { int64_t A, B, C, bias; };
+    Edge edges[3];
+    for (int i = 0; i < 3; i++) {
+        const Vertex& p = v[i];
+        const Vertex& q = v[(i + 1) % 3];
+        Edge& e = edges[i];
+        e.A = p.y - q.y;
+        e.B = q.x - p.x;
+        e.C = -(e.A * p.x + e.B * p.y);
+        bool top_left = e.A > 0 || (e.A == 0 && e.B > 0);
+        e.bias = top_left ? 0 : 1;
+    }
+
+    SpanSetup s = makeSetup(vram, env, attrs, v[0]);
+    const TexMode mode = texMode(attrs);
+
+    Gradient gr = {0, 0}, gg = {0, 0}, gb = {0, 0}, gu = {0, 0}, gv = {0, 0};
+    if (attrs.gouraud) {
+        gr = gradient(v[0].r, v[1].r, v[2].r, v[0], v[1], v[2], area);
+        gg = gradient(v[0].g, v[1].g, v[2].g, v[0], v[1], v[2], area);
+        gb = gradient(v[0].b, v[1].b, v[2].b, v[0], v[1], v[2], area);
+    }
+    if (attrs.textured) {
+        gu = gradient(v[0].u, v[1].u, v[2].u, v[0], v[1], v[2], area);
+        gv = gradient(v[0].v, v[1].v, v[2].v, v[0], v[1], v[2], area);
+    }
+    s.drdx = static_cast<int32_t>(gr.dx);
+    s.dgdx = static_cast<int32_t>(gg.dx);
+    s.dbdx = static_cast<int32_t>(gb.dx);
+    s.dudx = static_cast<int32_t>(gu.dx);
+    s.dvdx = static_cast<int32_t>(gv.dx);
+
+    auto at = [&](int32_t base, const Gradient& g, int32_t x, int32_t y) {
+        int64_t value = (static_cast<int64_t>(base) << FRAC_BITS) + g.dx * (x - v[0].x) + g.dy * (y - v[0].y) + HALF;
+        return static_cast<int32_t>(value);
+    };
+
+    const int32_t y_start = std::max<int32_t>(min_y, env.clip_y1);
+    const int32_t y_end = std::min<int32_t>(max_y, env.clip_y2);
+
+    for (int32_t y = y_start; y <= y_end; y++) {
+        int64_t xl = std::max<int32_t>(min_x, env.clip_x1);
+        int64_t xr = std::min<int32_t>(max_x, env.clip_x2);
+
+        for (const Edge& e : edges) {
+            int64_t row = e.B * y + e.C;
+            if (e.A > 0) {
+                xl = std::max(xl, ceilDiv(e.bias - row, e.A));
+            } else if (e.A < 0) {
+                xr = std::min(xr, floorDiv(row - e.bias, -e.A));
+            } else if (row < e.bias) {
+                xl = xr + 1;
+            }
+        }
+
+        if (xl > xr) continue;
+
+        const int32_t x = static_cast<int32_t>(xl);
+        Span span;
+        span.x = x;
+        span.y = y;
+        span.count = static_cast<int32_t>(xr - xl + 1);
+        span.r = at(v[0].r, gr, x, y);
+        span.g = at(v[0].g, gg, x, y);
+        span.b = at(v[0].b, gb, x, y);
+        span.u = at(v[0].u, gu, x, y);
+        span.v = at(v[0].v, gv, x, y);
+
+        dispatchSpan(mode, s, span);
+    }
+}
+
+void Rasterizer::drawRect(const DrawEnv& env, const PrimAttrs& attrs, const Vertex& origin, int32_t w, int32_t h, bool flip_x, bool flip_y) {
+    if (w <= 0 || h <= 0) return;
+
+    const int32_t x0 = origin.x + env.offset_x;
+    const int32_t y0 = origin.y + env.offset_y;
+
+    PrimAttrs flat = attrs;
+    flat.gouraud = false;
+
+    DrawEnv rect_env = env;
+    rect_env.dither = false;    // Rectangles are never dithered
+
+    SpanSetup s = makeSetup(vram, rect_env, flat, origin);
+    const TexMode mode = texMode(attrs);
+
+    const int32_t du = flip_x ? -1 : 1;
+    const int32_t dv = flip_y ? -1 : 1;
+    s.dudx = du * (1 << FRAC_BITS);
+
+    const int32_t x_start = std::max<int32_t>(x0, env.clip_x1);
+    const int32_t x_end = std::min<int32_t>(x0 + w - 1, env.clip_x2);
+    const int32_t y_start = std::max<int32_t>(y0, env.clip_y1);
+    const int32_t y_end = std::min<int32_t>(y0 + h - 1, env.clip_y2);
+
+    if (x_start > x_end) return;
+
+    for (int32_t y = y_start; y <= y_end; y++) {
+        Span span = {};
+        span.x = x_start;
+        span.y = y;
+        span.count = x_end - x_start + 1;
+        span.u = ((origin.u + du * (x_start - x0)) << FRAC_BITS) + HALF;
+        span.v = ((origin.v + dv * (y - y0)) << FRAC_BITS) + HALF;
+        dispatchSpan(mode, s, span);
+    }
+}
+
+void Rasterizer::drawLine(const DrawEnv& env, const PrimAttrs& attrs, const Vertex& a, const Vertex& b) {
+    const int32_t x0 = a.x + env.offset_x, y0 = a.y + env.offset_y;
+    const int32_t x1 = b.x + env.offset_x, y1 = b.y + env.offset_y;
+
+    const int32_t dx = x1 - x0, dy = y1 - y0;
+    if (std::abs(dx) >= VRAM_WIDTH || std::abs(dy) >= VRAM_HEIGHT) return;
+
+    PrimAttrs line_attrs = attrs;
+    line_attrs.textured = false;
+    line_attrs.raw = false;
+
+    SpanSetup s = makeSetup(vram, env, line_attrs, a);
+    const int32_t steps = std::max(std::abs(dx), std::abs(dy));
+
+    // One pixel per step; endpoints inclusive, positions rounded to nearest
+    for (int32_t i = 0; i <= steps; i++) {
+        int32_t x = x0, y = y0;
+        int32_t r = a.r, g = a.g, bl = a.b;
+        if (steps > 0) {
+            x = x0 + static_cast<int32_t>(floorDiv(static_cast<int64_t>(dx) * i * 2 + steps, 2 * steps));
+            y = y0 + static_cast<int32_t>(floorDiv(static_cast<int64_t>(dy) * i * 2 + steps, 2 * steps));
+            if (attrs.gouraud) {
+                r = a.r + (b.r - a.r) * i / steps;
+                g = a.g + (b.g - a.g) * i / steps;
+                bl = a.b + (b.b - a.b) * i / steps;
+            }
+        }
+
+        if (x < env.clip_x1 || x > env.clip_x2 || y < env.clip_y1 || y > env.clip_y2) continue;
+
+        Span span = {};
+        span.x = x;
+        span.y = y;
+        span.count = 1;
+        span.r = (r << FRAC_BITS) + HALF;
+        span.g = (g << FRAC_BITS) + HALF;
+        span.b = (bl << FRAC_BITS) + HALF;
+        drawSpan<TexMode::None>(s, span);
+    }
+}
+
+void Rasterizer::fillRect(uint16_t color, int32_t x, int32_t y, int32_t w, int32_t h) {
+    // Coordinates wrap around VRAM
+    for (int32_t row = 0; row < h; row++) {
+        uint16_t* line = vram + ((y + row) & (VRAM_HEIGHT - 1)) * VRAM_WIDTH;
+        int32_t start = x & (VRAM_WIDTH - 1);
+        int32_t first = std::min(w, VRAM_WIDTH - start);
+        std::fill(line + start, line + start + first, color);
+        if (first < w) std::fill(line, line + (w - first), color);
+    }
+}
+
+}
@@ -0,0 +1,247 @@
+/*
+    Description: Tile-Binned Parallel Rasterization Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "tile_binner.hpp"
+#include <algorithm>
+
+TileBinner::TileBinner(uint16_t* vram, unsigned worker_count) : rasterizer(vram) {
+    prims.reserve(MAX_PRIMS);
+    jobs.reserve(TILE_COUNT);
+
+    for (unsigned i = 0; i < worker_count; i++) {
+        workers.emplace_back(&TileBinner::workerLoop, this);
+    }
+}
+
+TileBinner::~TileBinner() {
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        quit = true;
+    }
+    start_cv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void TileBinner::addTriangle(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                             const Raster::Vertex& v0, const Raster::Vertex& v1, const Raster::Vertex& v2) {
+    Prim prim = {};
+    prim.kind = Kind::Triangle;
+    prim.env = env;
+    prim.attrs = attrs;
+    prim.v[0] = v0;
+    prim.v[1] = v1;
+    prim.v[2] = v2;
+
+    int32_t x1 = std::min({v0.x, v1.x, v2.x}) + env.offset_x;
+    int32_t x2 = std::max({v0.x, v1.x, v2.x}) + env.offset_x;
+    int32_t y1 = std::min({v0.y, v1.y, v2.y}) + env.offset_y;
+    int32_t y2 = std::max({v0.y, v1.y, v2.y}) + env.offset_y;
+    bin(prim, x1, y1, x2, y2);
+}
+
+void TileBinner::addRect(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                         const Raster::Vertex& origin, int32_t w, int32_t h, bool flip_x, bool flip_y) {
+    if (w <= 0 || h <= 0) return;
+
+    Prim prim = {};
+    prim.kind = Kind::Rect;
+    prim.env = env;
+    prim.attrs = attrs;
+    prim.v[0] = origin;
+    prim.w = w;
+    prim.h = h;
+    prim.flip_x = flip_x;
+    prim.flip_y = flip_y;
+
+    int32_t x1 = origin.x + env.offset_x;
+    int32_t y1 = origin.y + env.offset_y;
+    bin(prim, x1, y1, x1 + w - 1, y1 + h - 1);
+}
+
+void TileBinner::addLine(const Raster::DrawEnv& env, const Raster::PrimAttrs& attrs,
+                         const Raster::Vertex& v0, const Raster::Vertex& v1) {
+    Prim prim = {};
+    prim.kind = Kind::Line;
+    prim.env = env;
+    prim.attrs = attrs;
+    prim.v[0] = v0;
+    prim.v[1] = v1;
+
+    int32_t x1 = std::min(v0.x, v1.x) + env.offset_x;
+    int32_t x2 = std::max(v0.x, v1.x) + env.offset_x;
+    int32_t y1 = std::min(v0.y, v1.y) + env.offset_y;
+    int32_t y2 = std::max(v0.y, v1.y) + env.offset_y;
+    bin(prim, x1, y1, x2, y2);
+}
+
+TileBinner::TileMask TileBinner::tileMask(int32_t x, int32_t y, int32_t w, int32_t h) {
+    TileMask mask;
+    if (w <= 0 || h <= 0) return mask;
+
+    const int32_t tx1 = x / TILE_SIZE, tx2 = (x + std::min(w, Raster::VRAM_WIDTH) - 1) / TILE_SIZE;
+    const int32_t ty1 = y / TILE_SIZE, ty2 = (y + std::min(h, Raster::VRAM_HEIGHT) - 1) / TILE_SIZE;
+
+    for (int32_t ty = ty1; ty <= ty2; ty++) {
+        for (int32_t tx = tx1; tx <= tx2; tx++) {
+            mask.set((ty % TILES_Y) * TILES_X + (tx % TILES_X));
+        }
+    }
+    return mask;
+}
+
+TileBinner::TileMask TileBinner::textureMask(const Raster::PrimAttrs& attrs) {
+    static constexpr int32_t page_width[3] = {64, 128, 256};
+    static constexpr int32_t clut_width[3] = {16, 256, 0};
+    const int depth = static_cast<int>(attrs.depth);
+
+    TileMask mask = tileMask(attrs.texpage_x, attrs.texpage_y, page_width[depth], 256);
+
+    // The CLUT is addressed linearly and runs on into the next line
+    const int32_t first = std::min(clut_width[depth], Raster::VRAM_WIDTH - attrs.clut_x);
+    mask |= tileMask(attrs.clut_x, attrs.clut_y, first, 1);
+    mask |= tileMask(0, (attrs.clut_y + 1) % Raster::VRAM_HEIGHT, clut_width[depth] - first, 1);
+    return mask;
+}
+
+void TileBinner::bin(const Prim& prim, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    // Clip the bounding box to the drawing area; nothing outside it is ever written
+    x1 = std::max<int32_t>(x1, prim.env.clip_x1);
+    y1 = std::max<int32_t>(y1, prim.env.clip_y1);
+    x2 = std::min<int32_t>(x2, prim.env.clip_x2);
+    y2 = std::min<int32_t>(y2, prim.env.clip_y2);
+    if (x1 > x2 || y1 > y2) return;
+
+    const TileMask target = tileMask(x1, y1, x2 - x1 + 1, y2 - y1 + 1);
+    const TileMask source = prim.attrs.textured ? textureMask(prim.attrs) : TileMask();
+
+    // Tiles run independently, so no primitive may read texels another tile writes:
+    // sampling pending output, or overwriting texels a pending primitive samples.
+    // Feedback within a single primitive depends on scanline order, which tiling
+    // changes, so such primitives are drawn directly once the bins are empty.
+    const bool feedback = (source & target).any();
+    if (feedback || (source & dirty).any() || (target & sampled).any()) {
+        flush();
+    }
+    if (feedback) {
+        draw(prim, prim.env);
+        return;
+    }
+
+    if (prims.size() >= MAX_PRIMS) {
+        flush();
+    }
+
+    const uint32_t index = static_cast<uint32_t>(prims.size());
+    prims.push_back(prim);
+
+    for (int t = 0; t < TILE_COUNT; t++) {
+        if (target[t]) tiles[t].push_back(index);
+    }
+    dirty |= target;
+    sampled |= source;
+}
+
+bool TileBinner::overlapsPending(int32_t x, int32_t y, int32_t w, int32_t h) const {
+    return (tileMask(x, y, w, h) & (dirty | sampled)).any();
+}
+
+void TileBinner::flush() {
+    if (prims.empty()) return;
+
+    jobs.clear();
+    for (int t = 0; t < TILE_COUNT; t++) {
+        if (dirty[t]) jobs.push_back(t);
+    }
+
+    next_job.store(0, std::memory_order_relaxed);
+
+    if (workers.empty() || jobs.size() == 1) {
+        runJobs();
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            generation++;
+            busy_workers = static_cast<unsigned>(workers.size());
+        }
+        start_cv.notify_all();
+
+        // The submitting thread takes tiles too
+        runJobs();
+
+        std::unique_lock<std::mutex> lock(pool_mutex);
+        done_cv.wait(lock, [this] { return busy_workers == 0; });
+    }
+
+    for (int t : jobs) {
+        tiles[t].clear();
+    }
+    prims.clear();
+    dirty.reset();
+    sampled.reset();
+}
+
+void TileBinner::runJobs() {
+    for (;;) {
+        size_t i = next_job.fetch_add(1, std::memory_order_relaxed);
+        if (i >= jobs.size()) break;
+        renderTile(jobs[i]);
+    }
+}
+
+void TileBinner::renderTile(int tile) {
+    const int32_t tile_x1 = (tile % TILES_X) * TILE_SIZE;
+    const int32_t tile_y1 = (tile / TILES_X) * TILE_SIZE;
+    const int32_t tile_x2 = tile_x1 + TILE_SIZE - 1;
+    const int32_t tile_y2 = tile_y1 + TILE_SIZE - 1;
+
+    for (uint32_t index : tiles[tile]) {
+        const Prim& prim = prims[index];
+
+        Raster::DrawEnv env = prim.env;
+        env.clip_x1 = static_cast<int16_t>(std::max<int32_t>(env.clip_x1, tile_x1));
+        env.clip_y1 = static_cast<int16_t>(std::max<int32_t>(env.clip_y1, tile_y1));
+        env.clip_x2 = static_cast<int16_t>(std::min<int32_t>(env.clip_x2, tile_x2));
+        env.clip_y2 = static_cast<int16_t>(std::min<int32_t>(env.clip_y2, tile_y2));
+
+        draw(prim, env);
+    }
+}
+
+void TileBinner::draw(const Prim& prim, const Raster::DrawEnv& env) {
+    switch (prim.kind) {
+        case Kind::Triangle:
+            rasterizer.drawTriangle(env, prim.attrs, prim.v[0], prim.v[1], prim.v[2]);
+            break;
+        case Kind::Rect:
+            rasterizer.drawRect(env, prim.attrs, prim.v[0], prim.w, prim.h, prim.flip_x, prim.flip_y);
+            break;
+        case Kind::Line:
+            rasterizer.drawLine(env, prim.attrs, prim.v[0], prim.v[1]);
+            break;
+    }
+}
+
+void TileBinner::workerLoop() {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            start_cv.wait(lock, [&] { return quit || generation != seen; });
+            if (quit) return;
+            seen = generation;
+        }
+
+        runJobs();
+
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (--busy_workers == 0) {
+            done_cv.notify_one();
+        }
+    }
+}
@@ -0,0 +1,318 @@
+/*
+    Description: SDL Video Output Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "video_output.hpp"
+#include "controller.hpp"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    constexpr int VRAM_WIDTH = 1024;
+    constexpr int VRAM_HEIGHT = 512;
+
+    // Halfwords of VRAM behind one output row (640 pixels at 24 bits)
+    constexpr int SHADOW_PITCH = 640 * 3 / 2;
+
+    constexpr int WINDOW_WIDTH = 640;
+    constexpr int WINDOW_HEIGHT = 480;
+
+    constexpr uint32_t expand5(uint32_t c) { return (c << 3) | (c >> 2); }
+
+    // Keyboard layout of pad 1
+    uint16_t padButton(SDL_Keycode key) {
+        switch (key) {
+            case SDLK_UP: return PAD_UP;
+            case SDLK_DOWN: return PAD_DOWN;
+            case SDLK_LEFT: return PAD_LEFT;
+            case SDLK_RIGHT: return PAD_RIGHT;
+            case SDLK_RETURN: return PAD_START;
+            case SDLK_BACKSPACE: return PAD_SELECT;
+            case SDLK_z: return PAD_CROSS;
+            case SDLK_x: return PAD_CIRCLE;
+            case SDLK_a: return PAD_SQUARE;
+            case SDLK_s: return PAD_TRIANGLE;
+            case SDLK_q: return PAD_L1;
+            case SDLK_w: return PAD_R1;
+            case SDLK_e: return PAD_L2;
+            case SDLK_r: return PAD_R2;
+            default: return 0;
+        }
+    }
+}
+
+VideoOutput::VideoOutput() {
+    for (auto& word : dirty) word.store(0, std::memory_order_relaxed);
+}
+
+VideoOutput::~VideoOutput() {
+    close();
+}
+
+bool VideoOutput::open() {
+    if (window) return true;
+
+    if (SDL_InitSubSystem(SDL_INIT_VIDEO) != 0) {
+        std::cerr << "[Video] SDL video init failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    window = SDL_CreateWindow("PS1", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+                              WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_RESIZABLE);
+    if (!window) {
+        std::cerr << "[Video] Failed to create window: " << SDL_GetError() << std::endl;
+        SDL_QuitSubSystem(SDL_INIT_VIDEO);
+        return false;
+    }
+
+    for (Frame& frame : frames) {
+        frame.pixels.assign(MAX_WIDTH * MAX_HEIGHT, 0);
+        frame.width = frame.height = 0;
+    }
+    shadow.assign(MAX_HEIGHT * SHADOW_PITCH, 0);
+    last_area = {};
+    for (TileSet& tiles : stale) tiles.set();
+
+    quit = false;
+    frame_pending = false;
+    presenter = std::thread(&VideoOutput::presentLoop, this);
+    return true;
+}
+
+void VideoOutput::close() {
+    if (!window) return;
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        quit = true;
+    }
+    wake.notify_one();
+    presenter.join();
+
+    SDL_DestroyWindow(window);
+    SDL_QuitSubSystem(SDL_INIT_VIDEO);
+    window = nullptr;
+}
+
+FrameSink VideoOutput::sink() {
+    FrameSink sink;
+    sink.ctx = this;
+    sink.present = &VideoOutput::sinkPresent;
+    return sink;
+}
+
+// --- Emulation thread ---
+
+void VideoOutput::sinkPresent(void* ctx, const uint16_t* vram, const DisplayArea& area) {
+    VideoOutput* out = static_cast<VideoOutput*>(ctx);
+    out->publish(out->diffDisplayArea(vram, area));
+}
+
+// Window and keyboard events are tied to the thread that created the window
+void VideoOutput::pollEvents() {
+    if (!window) return;
+
+    SDL_Event event;
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_QUIT) {
+            close_requested.store(true, std::memory_order_relaxed);
+        } else if (event.type == SDL_KEYDOWN) {
+            pad_buttons |= padButton(event.key.keysym.sym);
+        } else if (event.type == SDL_KEYUP) {
+            pad_buttons &= ~padButton(event.key.keysym.sym);
+        }
+    }
+}
+
+// Compare the display area against last frame's copy; changed tiles are refreshed in the copy
+VideoOutput::TileSet VideoOutput::diffDisplayArea(const uint16_t* vram, const DisplayArea& area) {
+    TileSet changed;
+    const bool full = area != last_area;
+    last_area = area;
+    if (full) changed.set();
+    if (!area.enabled) return changed;
+
+    const int width = std::min<int>(area.width, MAX_WIDTH);
+    const int height = std::min<int>(area.height, MAX_HEIGHT);
+    const int span = area.rgb24 ? (width * 3 + 1) / 2 : width;
+
+    uint16_t wrapped[VRAM_WIDTH];
+    for (int y = 0; y < height; y++) {
+        const uint16_t* row = &vram[((area.y + y) & (VRAM_HEIGHT - 1)) * VRAM_WIDTH];
+        const uint16_t* line = row + area.x;
+        if (area.x + span > VRAM_WIDTH) {
+            for (int i = 0; i < span; i++) wrapped[i] = row[(area.x + i) & (VRAM_WIDTH - 1)];
+            line = wrapped;
+        }
+
+        uint16_t* copy = &shadow[y * SHADOW_PITCH];
+        for (int col = 0; col * TILE_W < width; col++) {
+            const int x0 = col * TILE_W;
+            const int x1 = std::min(x0 + TILE_W, width);
+            const int h0 = area.rgb24 ? x0 * 3 / 2 : x0;
+            const int h1 = area.rgb24 ? std::min((x1 * 3 + 1) / 2, span) : x1;
+            const size_t bytes = (h1 - h0) * sizeof(uint16_t);
+
+            if (full || std::memcmp(line + h0, copy + h0, bytes) != 0) {
+                changed.set((y / TILE_H) * TILE_COLS + col);
+                std::memcpy(copy + h0, line + h0, bytes);
+            }
+        }
+    }
+    return changed;
+}
+
+// Converts from the shadow copy, which holds the current source of every tile
+void VideoOutput::convertTile(int tile, Frame& frame) const {
+    const DisplayArea& area = last_area;
+    const int x0 = (tile % TILE_COLS) * TILE_W;
+    const int y0 = (tile / TILE_COLS) * TILE_H;
+    const int x1 = std::min(x0 + TILE_W, frame.width);
+    const int y1 = std::min(y0 + TILE_H, frame.height);
+
+    for (int y = y0; y < y1; y++) {
+        uint32_t* dst = &frame.pixels[y * MAX_WIDTH];
+        if (!area.enabled) {
+            std::fill(dst + x0, dst + x1, 0);
+            continue;
+        }
+
+        const uint16_t* row = &shadow[y * SHADOW_PITCH];
+        if (area.rgb24) {
+            auto byteAt = [&](int b) -> uint32_t {
+                const uint16_t half = row[b >> 1];
+                return (b & 1) ? half >> 8 : half & 0xFF;
+            };
+            for (int x = x0; x < x1; x++) {
+                dst[x] = byteAt(x * 3) << 16 | byteAt(x * 3 + 1) << 8 | byteAt(x * 3 + 2);
+            }
+        } else {
+            for (int x = x0; x < x1; x++) {
+                const uint16_t p = row[x];
+                dst[x] = expand5(p & 31) << 16 | expand5((p >> 5) & 31) << 8 | expand5((p >> 10) & 31);
+            }
+        }
+    }
+}
+
+void VideoOutput::publish(const TileSet& changed) {
+    const int slot = buffer.back();
+    Frame& frame = frames[slot];
+    frame.width = std::min<int>(last_area.width, MAX_WIDTH);
+    frame.height = std::max(std::min<int>(last_area.height, MAX_HEIGHT), 1);
+
+    // The back slot last held a frame from two publishes ago: bring every tile
+    // that changed since then up to date, not just this frame's
+    for (TileSet& tiles : stale) tiles |= changed;
+    const TileSet& todo = stale[slot];
+    for (int tile = 0; tile < TILE_COUNT; tile++) {
+        if (todo[tile]) convertTile(tile, frame);
+    }
+    stale[slot].reset();
+
+    buffer.publish();
+    published.fetch_add(1, std::memory_order_relaxed);
+
+    // Posted after the frame, so a presenter that sees these bits will also see
+    // this frame (or a newer one) when it next acquires
+    for (int w = 0; w < DIRTY_WORDS; w++) {
+        uint64_t bits = 0;
+        for (int b = 0; b < 64 && w * 64 + b < TILE_COUNT; b++) {
+            if (changed[w * 64 + b]) bits |= uint64_t(1) << b;
+        }
+        if (bits) dirty[w].fetch_or(bits, std::memory_order_release);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        frame_pending = true;
+    }
+    wake.notify_one();
+}
+
+// --- Presenter thread ---
+
+VideoOutput::TileSet VideoOutput::takeDirty() {
+    TileSet tiles;
+    for (int w = 0; w < DIRTY_WORDS; w++) {
+        const uint64_t bits = dirty[w].exchange(0, std::memory_order_acquire);
+        for (int b = 0; b < 64 && w * 64 + b < TILE_COUNT; b++) {
+            if (bits & (uint64_t(1) << b)) tiles.set(w * 64 + b);
+        }
+    }
+    return tiles;
+}
+
+// The renderer lives and dies on this thread; SDL_RenderPresent may block on
+// vsync here without holding up emulation
+void VideoOutput::presentLoop() {
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    if (!renderer) renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    if (!renderer) {
+        std::cerr << "[Video] Failed to create renderer: " << SDL_GetError() << std::endl;
+        return;
+    }
+
+    SDL_Texture* texture = nullptr;
+    int texture_w = 0, texture_h = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait(lock, [&] { return quit || frame_pending; });
+            if (quit) break;
+            frame_pending = false;
+        }
+
+        // Dirty bits first: any frame they were posted for is visible to the acquire
+        TileSet tiles = takeDirty();
+        buffer.acquire();
+        const Frame& frame = frames[buffer.front()];
+        if (frame.width == 0) continue;
+
+        if (!texture || frame.width != texture_w || frame.height != texture_h) {
+            if (texture) SDL_DestroyTexture(texture);
+            texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGB888, SDL_TEXTUREACCESS_STREAMING,
+                                        frame.width, frame.height);
+            if (!texture) {
+                std::cerr << "[Video] Failed to create texture: " << SDL_GetError() << std::endl;
+                break;
+            }
+            texture_w = frame.width;
+            texture_h = frame.height;
+            tiles.set();
+        }
+
+        // One upload per run of dirty tiles along a tile row
+        for (int row = 0; row * TILE_H < frame.height; row++) {
+            int col = 0;
+            while (col * TILE_W < frame.width) {
+                if (!tiles[row * TILE_COLS + col]) {
+                    col++;
+                    continue;
+                }
+                const int first = col;
+                while (col * TILE_W < frame.width && tiles[row * TILE_COLS + col]) col++;
+
+                SDL_Rect rect;
+                rect.x = first * TILE_W;
+                rect.y = row * TILE_H;
+                rect.w = std::min(col * TILE_W, frame.width) - rect.x;
+                rect.h = std::min(TILE_H, frame.height - rect.y);
+                SDL_UpdateTexture(texture, &rect, &frame.pixels[rect.y * MAX_WIDTH + rect.x], MAX_WIDTH * sizeof(uint32_t));
+            }
+        }
+
+        SDL_RenderClear(renderer);
+        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+        SDL_RenderPresent(renderer);
+        presented.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (texture) SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer);
+}
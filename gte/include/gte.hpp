@@ -0,0 +1,103 @@
+/*
+    Description: Geometry Transformation Engine (COP2) Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <cstdint>
+
+class GTE {
+    public:
+        GTE();
+
+        void init();
+
+        // MFC2/MTC2/LWC2/SWC2 (data registers 0-31)
+        uint32_t readData(uint32_t index) const;
+        void writeData(uint32_t index, uint32_t value);
+
+        // CFC2/CTC2 (control registers 0-31)
+        uint32_t readControl(uint32_t index) const;
+        void writeControl(uint32_t index, uint32_t value);
+
+        // COP2 imm25 command
+        void execute(uint32_t command);
+
+        // Name of the matrix kernel picked for this CPU (scalar / sse4.1 / avx2)
+        static const char* backend();
+
+    private:
+        // --- Arithmetic helpers (accumulate FLAG bits) ---
+
+        // MAC/IR = (T << 12 + M * V) SAR (sf * 12) through the vector kernel.
+        // Returns the unshifted third row, which RTPS uses for depth.
+        int64_t transform(const int16_t m[3][3], const int16_t v[3], const int32_t t[3], bool sf, bool lm);
+
+        void setMac(int index, int64_t value, int shift);
+        void setIr(int index, int32_t value, bool lm);
+        void setMacIr(int index, int64_t value, int shift, bool lm);
+        int64_t checkMac0(int64_t value);
+        void setIr0(int32_t value);
+
+        void pushSXY(int16_t x, int16_t y);
+        void pushSZ(int32_t z);
+        void pushColor();
+        uint32_t divide(uint32_t lhs, uint32_t rhs);
+
+        // Lighting stages shared by the NC*/CC/CDP family
+        void light(int index, bool sf, bool lm);
+        void colorMatrix(bool sf, bool lm);
+        void colorScale(bool sf, bool lm);
+        void depthCue(bool sf, bool lm);
+        void interpolate(int64_t m1, int64_t m2, int64_t m3, bool sf, bool lm);
+
+        // --- Commands ---
+        void rtp(int index, bool sf, bool lm, bool last);
+        void nclip();
+        void op(bool sf, bool lm);
+        void mvmva(uint32_t command, bool sf, bool lm);
+        void dpcs(uint32_t color, bool sf, bool lm);
+        void dcpl(bool sf, bool lm);
+        void intpl(bool sf, bool lm);
+        void sqr(bool sf, bool lm);
+        void nc(int index, bool sf, bool lm);
+        void ncc(int index, bool sf, bool lm);
+        void ncd(int index, bool sf, bool lm);
+        void cc(bool sf, bool lm);
+        void cdp(bool sf, bool lm);
+        void avsz3();
+        void avsz4();
+        void gpf(bool sf, bool lm);
+        void gpl(bool sf, bool lm);
+
+        // --- Data registers ---
+        int16_t V[3][3];            // VX/VY/VZ 0-2
+        uint32_t rgbc;
+        uint16_t otz;
+        int16_t ir0;
+        int16_t ir[3];              // IR1-3
+        int16_t sx[3], sy[3];       // Screen XY FIFO
+        uint16_t sz[4];             // Screen Z FIFO (SZ0-SZ3)
+        uint32_t rgb[3];            // Colour FIFO
+        uint32_t res1;
+        int32_t mac0;
+        int32_t mac[3];             // MAC1-3
+        uint32_t lzcs;
+        uint32_t lzcr;
+
+        // --- Control registers ---
+        int16_t RT[3][3];           // Rotation
+        int32_t TR[3];              // Translation
+        int16_t LLM[3][3];          // Light source directions
+        int32_t BK[3];              // Background colour
+        int16_t LCM[3][3];          // Light colours
+        int32_t FC[3];              // Far colour
+        int32_t ofx, ofy;
+        uint16_t h;
+        int16_t dqa;
+        int32_t dqb;
+        int16_t zsf3, zsf4;
+        uint32_t flag;
+};
@@ -0,0 +1,777 @@
+/*
+    Description: Geometry Transformation Engine (COP2) Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "gte.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+
+// The SSE4.1 and AVX2 kernels are compiled with per-function target attributes
+// and one is picked at startup from CPUID, so a baseline x86-64 build uses them
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GTE_X86 1
+#endif
+
+namespace {
+
+    // FLAG register bits
+    constexpr uint32_t FLAG_MAC1_POS = 1u << 30;    // MAC2/MAC3 follow at >> 1, >> 2
+    constexpr uint32_t FLAG_MAC1_NEG = 1u << 27;
+    constexpr uint32_t FLAG_IR1      = 1u << 24;
+    constexpr uint32_t FLAG_COLOR_R  = 1u << 21;
+    constexpr uint32_t FLAG_SZ_OTZ   = 1u << 18;
+    constexpr uint32_t FLAG_DIVIDE   = 1u << 17;
+    constexpr uint32_t FLAG_MAC0_POS = 1u << 16;
+    constexpr uint32_t FLAG_MAC0_NEG = 1u << 15;
+    constexpr uint32_t FLAG_SX2      = 1u << 14;
+    constexpr uint32_t FLAG_SY2      = 1u << 13;
+    constexpr uint32_t FLAG_IR0      = 1u << 12;
+    constexpr uint32_t FLAG_ERROR    = 1u << 31;
+    constexpr uint32_t FLAG_ERROR_SOURCES = 0x7F87E000;
+    constexpr uint32_t FLAG_WRITABLE = 0x7FFFF000;
+
+    // MAC1-3 hold 44-bit intermediate sums
+    constexpr int64_t MAC_MAX = (int64_t(1) << 43) - 1;
+    constexpr int64_t MAC_MIN = -(int64_t(1) << 43);
+
+    constexpr int32_t ZERO_VECTOR[3] = {0, 0, 0};
+
+    // Seed table for the Newton-Raphson reciprocal used by RTPS/RTPT
+    constexpr std::array<uint8_t, 257> makeUnrTable() {
+        std::array<uint8_t, 257> table{};
+        for (int i = 0; i < 257; i++) {
+            table[i] = static_cast<uint8_t>(std::max(0, (0x40000 / (i + 0x100) + 1) / 2 - 0x101));
+        }
+        return table;
+    }
+    constexpr std::array<uint8_t, 257> UNR_TABLE = makeUnrTable();
+
+    inline int64_t signExtend44(int64_t value) {
+        return static_cast<int64_t>(static_cast<uint64_t>(value) << 20) >> 20;
+    }
+
+    inline uint32_t macOverflow(int row, int64_t value) {
+        if (value > MAC_MAX) return FLAG_MAC1_POS >> row;
+        if (value < MAC_MIN) return FLAG_MAC1_NEG >> row;
+        return 0;
+    }
+
+    // Row bitmask (bit 0 = row 0) to FLAG bits starting at `first`
+    inline uint32_t rowFlags(int rows, uint32_t first) {
+        uint32_t flags = 0;
+        for (int row = 0; row < 3; row++) {
+            if (rows & (1 << row)) flags |= first >> row;
+        }
+        return flags;
+    }
+
+    // Matrix x vector product shared by RTPS/RTPT, MVMVA and the lighting commands:
+    // MAC = (T << 12 + M * V) SAR shift, IR = saturate(MAC). Each partial sum is checked
+    // against 44 bits and wrapped, matching the hardware's accumulator. The arrays are
+    // padded to a full vector so the SIMD kernels can store whole registers.
+    struct Product {
+        int64_t raw[4];     // Final sum before the shift
+        int32_t mac[4];
+        int32_t ir[4];
+    };
+
+    uint32_t matVecScalar(const int16_t m[3][3], const int16_t v[3], const int32_t t[3], int shift, bool lm, Product& p) {
+        const int32_t ir_min = lm ? 0 : -0x8000;
+        uint32_t flags = 0;
+
+        for (int row = 0; row < 3; row++) {
+            int64_t sum = (static_cast<int64_t>(t[row]) << 12) + static_cast<int32_t>(m[row][0]) * v[0];
+            flags |= macOverflow(row, sum);
+            sum = signExtend44(sum) + static_cast<int32_t>(m[row][1]) * v[1];
+            flags |= macOverflow(row, sum);
+            sum = signExtend44(sum) + static_cast<int32_t>(m[row][2]) * v[2];
+            flags |= macOverflow(row, sum);
+
+            p.raw[row] = sum;
+            p.mac[row] = static_cast<int32_t>(sum >> shift);
+            p.ir[row] = std::clamp<int32_t>(p.mac[row], ir_min, 0x7FFF);
+            if (p.ir[row] != p.mac[row]) flags |= FLAG_IR1 >> row;
+        }
+        return flags;
+    }
+
+#if defined(GTE_X86)
+
+    // MAC1-3 (low 32 bits of each shifted sum) to IR1-3 with saturation flags
+    __attribute__((target("sse4.1")))
+    inline uint32_t saturateIR(__m128i mac, bool lm, Product& p) {
+        const __m128i ir = _mm_min_epi32(_mm_max_epi32(mac, _mm_set1_epi32(lm ? 0 : -0x8000)), _mm_set1_epi32(0x7FFF));
+        const int clamped = ~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(ir, mac))) & 7;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p.mac), mac);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p.ir), ir);
+        return rowFlags(clamped, FLAG_IR1);
+    }
+
+    // Rows 0-2 live in the 64-bit lanes of one register
+    __attribute__((target("avx2")))
+    uint32_t matVecAVX2(const int16_t m[3][3], const int16_t v[3], const int32_t t[3], int shift, bool lm, Product& p) {
+        const __m256i mask44 = _mm256_set1_epi64x((int64_t(1) << 44) - 1);
+        const __m256i sign44 = _mm256_set1_epi64x(int64_t(1) << 43);
+        const __m256i max = _mm256_set1_epi64x(MAC_MAX);
+        const __m256i min = _mm256_set1_epi64x(MAC_MIN);
+
+        __m256i sum = _mm256_set_epi64x(0, int64_t(t[2]) << 12, int64_t(t[1]) << 12, int64_t(t[0]) << 12);
+        int pos = 0, neg = 0;
+
+        for (int col = 0; col < 3; col++) {
+            if (col > 0) {
+                sum = _mm256_sub_epi64(_mm256_xor_si256(_mm256_and_si256(sum, mask44), sign44), sign44);
+            }
+            const __m256i mcol = _mm256_set_epi64x(0, m[2][col], m[1][col], m[0][col]);
+            sum = _mm256_add_epi64(sum, _mm256_mul_epi32(mcol, _mm256_set1_epi64x(v[col])));
+
+            pos |= _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(sum, max)));
+            neg |= _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(min, sum)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p.raw), sum);
+
+        // Only the low 32 bits survive, so a logical shift matches SAR here
+        sum = _mm256_srl_epi64(sum, _mm_cvtsi32_si128(shift));
+        const __m128i mac = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(sum, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0)));
+
+        return rowFlags(pos, FLAG_MAC1_POS) | rowFlags(neg, FLAG_MAC1_NEG) | saturateIR(mac, lm, p);
+    }
+
+    __attribute__((target("sse4.1")))
+    inline __m128i wrap44(__m128i sum) {
+        const __m128i mask44 = _mm_set1_epi64x((int64_t(1) << 44) - 1);
+        const __m128i sign44 = _mm_set1_epi64x(int64_t(1) << 43);
+        return _mm_sub_epi64(_mm_xor_si128(_mm_and_si128(sum, mask44), sign44), sign44);
+    }
+
+    // SSE4.1 has no 64-bit compare: a sum is in range iff (sum + 2^43) >> 44 == 0
+    __attribute__((target("sse4.1")))
+    inline int outOfRange(__m128i sum) {
+        const __m128i biased = _mm_add_epi64(sum, _mm_set1_epi64x(int64_t(1) << 43));
+        const __m128i high = _mm_srli_epi64(biased, 44);
+        return ~_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(high, _mm_setzero_si128()))) & 3;
+    }
+
+    // Rows 0-1 in `lo`, row 2 in the low lane of `hi`
+    __attribute__((target("sse4.1")))
+    uint32_t matVecSSE41(const int16_t m[3][3], const int16_t v[3], const int32_t t[3], int shift, bool lm, Product& p) {
+        __m128i lo = _mm_set_epi64x(int64_t(t[1]) << 12, int64_t(t[0]) << 12);
+        __m128i hi = _mm_set_epi64x(0, int64_t(t[2]) << 12);
+        int pos = 0, neg = 0;
+
+        for (int col = 0; col < 3; col++) {
+            if (col > 0) {
+                lo = wrap44(lo);
+                hi = wrap44(hi);
+            }
+            const __m128i vcol = _mm_set1_epi64x(v[col]);
+            lo = _mm_add_epi64(lo, _mm_mul_epi32(_mm_set_epi64x(m[1][col], m[0][col]), vcol));
+            hi = _mm_add_epi64(hi, _mm_mul_epi32(_mm_set_epi64x(0, m[2][col]), vcol));
+
+            const int out = outOfRange(lo) | (outOfRange(hi) << 2);
+            const int sign = _mm_movemask_pd(_mm_castsi128_pd(lo)) | (_mm_movemask_pd(_mm_castsi128_pd(hi)) << 2);
+            pos |= out & ~sign;
+            neg |= out & sign;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p.raw), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p.raw + 2), hi);
+
+        // Only the low 32 bits survive, so a logical shift matches SAR here
+        const __m128i count = _mm_cvtsi32_si128(shift);
+        lo = _mm_srl_epi64(lo, count);
+        hi = _mm_srl_epi64(hi, count);
+        const __m128i mac = _mm_unpacklo_epi64(_mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 3, 2, 0)), hi);
+
+        return rowFlags(pos & 7, FLAG_MAC1_POS) | rowFlags(neg & 7, FLAG_MAC1_NEG) | saturateIR(mac, lm, p);
+    }
+
+#endif
+
+    using MatVecKernel = uint32_t (*)(const int16_t m[3][3], const int16_t v[3], const int32_t t[3], int shift, bool lm, Product& p);
+
+    struct Kernel {
+        MatVecKernel matVec;
+        const char* name;
+    };
+
+    Kernel selectKernel() {
+#if defined(GTE_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return {matVecAVX2, "avx2"};
+        if (__builtin_cpu_supports("sse4.1")) return {matVecSSE41, "sse4.1"};
+#endif
+        return {matVecScalar, "scalar"};
+    }
+
+    const Kernel kernel = selectKernel();
+
+    inline uint32_t matVec(const int16_t m[3][3], const int16_t v[3], const int32_t t[3], int shift, bool lm, Product& p) {
+        const uint32_t flags = kernel.matVec(m, v, t, shift, lm, p);
+#ifdef DEBUG
+        // Check the vector kernel against the reference on every call in debug builds
+        if (kernel.matVec != matVecScalar) {
+            Product ref;
+            const uint32_t ref_flags = matVecScalar(m, v, t, shift, lm, ref);
+            assert(flags == ref_flags);
+            assert(std::memcmp(ref.raw, p.raw, sizeof(int64_t) * 3) == 0);
+            assert(std::memcmp(ref.mac, p.mac, sizeof(int32_t) * 3) == 0);
+            assert(std::memcmp(ref.ir, p.ir, sizeof(int32_t) * 3) == 0);
+            (void)ref_flags;
+        }
+#endif
+        return flags;
+    }
+
+    inline uint32_t readMatrix(const int16_t m[3][3], uint32_t reg) {
+        const int16_t* e = &m[0][0];
+        if (reg == 4) return static_cast<uint32_t>(static_cast<int32_t>(e[8]));
+        return static_cast<uint16_t>(e[reg * 2]) | (static_cast<uint32_t>(static_cast<uint16_t>(e[reg * 2 + 1])) << 16);
+    }
+
+    inline void writeMatrix(int16_t m[3][3], uint32_t reg, uint32_t value) {
+        int16_t* e = &m[0][0];
+        e[reg * 2] = static_cast<int16_t>(value);
+        if (reg < 4) e[reg * 2 + 1] = static_cast<int16_t>(value >> 16);
+    }
+
+    inline uint32_t packXY(int16_t x, int16_t y) {
+        return static_cast<uint16_t>(x) | (static_cast<uint32_t>(static_cast<uint16_t>(y)) << 16);
+    }
+
+    inline int32_t colorComponent(uint32_t color, int index) {
+        return (color >> (index * 8)) & 0xFF;
+    }
+
+}
+
+GTE::GTE() {
+    init();
+}
+
+void GTE::init() {
+    std::memset(V, 0, sizeof(V));
+    rgbc = 0;
+    otz = 0;
+    ir0 = 0;
+    std::memset(ir, 0, sizeof(ir));
+    std::memset(sx, 0, sizeof(sx));
+    std::memset(sy, 0, sizeof(sy));
+    std::memset(sz, 0, sizeof(sz));
+    std::memset(rgb, 0, sizeof(rgb));
+    res1 = 0;
+    mac0 = 0;
+    std::memset(mac, 0, sizeof(mac));
+    lzcs = 0;
+    lzcr = 32;
+
+    std::memset(RT, 0, sizeof(RT));
+    std::memset(TR, 0, sizeof(TR));
+    std::memset(LLM, 0, sizeof(LLM));
+    std::memset(BK, 0, sizeof(BK));
+    std::memset(LCM, 0, sizeof(LCM));
+    std::memset(FC, 0, sizeof(FC));
+    ofx = ofy = 0;
+    h = 0;
+    dqa = 0;
+    dqb = 0;
+    zsf3 = zsf4 = 0;
+    flag = 0;
+}
+
+const char* GTE::backend() {
+    return kernel.name;
+}
+
+// --- Register access ---
+
+uint32_t GTE::readData(uint32_t index) const {
+    switch (index & 0x1F) {
+        case 0: case 2: case 4:
+            return packXY(V[index / 2][0], V[index / 2][1]);
+        case 1: case 3: case 5:
+            return static_cast<uint32_t>(static_cast<int32_t>(V[index / 2][2]));
+        case 6:  return rgbc;
+        case 7:  return otz;
+        case 8:  return static_cast<uint32_t>(static_cast<int32_t>(ir0));
+        case 9: case 10: case 11:
+            return static_cast<uint32_t>(static_cast<int32_t>(ir[index - 9]));
+        case 12: case 13: case 14:
+            return packXY(sx[index - 12], sy[index - 12]);
+        case 15: return packXY(sx[2], sy[2]);
+        case 16: case 17: case 18: case 19:
+            return sz[index - 16];
+        case 20: case 21: case 22:
+            return rgb[index - 20];
+        case 23: return res1;
+        case 24: return static_cast<uint32_t>(mac0);
+        case 25: case 26: case 27:
+            return static_cast<uint32_t>(mac[index - 25]);
+        case 28: case 29: {
+            // IRGB reads back as ORGB
+            uint32_t value = 0;
+            for (int i = 0; i < 3; i++) {
+                value |= static_cast<uint32_t>(std::clamp(ir[i] >> 7, 0, 0x1F)) << (i * 5);
+            }
+            return value;
+        }
+        case 30: return lzcs;
+        default: return lzcr;
+    }
+}
+
+void GTE::writeData(uint32_t index, uint32_t value) {
+    switch (index & 0x1F) {
+        case 0: case 2: case 4:
+            V[index / 2][0] = static_cast<int16_t>(value);
+            V[index / 2][1] = static_cast<int16_t>(value >> 16);
+            break;
+        case 1: case 3: case 5:
+            V[index / 2][2] = static_cast<int16_t>(value);
+            break;
+        case 6:  rgbc = value; break;
+        case 7:  otz = static_cast<uint16_t>(value); break;
+        case 8:  ir0 = static_cast<int16_t>(value); break;
+        case 9: case 10: case 11:
+            ir[index - 9] = static_cast<int16_t>(value);
+            break;
+        case 12: case 13: case 14:
+            sx[index - 12] = static_cast<int16_t>(value);
+            sy[index - 12] = static_cast<int16_t>(value >> 16);
+            break;
+        case 15: pushSXY(static_cast<int16_t>(value), static_cast<int16_t>(value >> 16)); break;
+        case 16: case 17: case 18: case 19:
+            sz[index - 16] = static_cast<uint16_t>(value);
+            break;
+        case 20: case 21: case 22:
+            rgb[index - 20] = value;
+            break;
+        case 23: res1 = value; break;
+        case 24: mac0 = static_cast<int32_t>(value); break;
+        case 25: case 26: case 27:
+            mac[index - 25] = static_cast<int32_t>(value);
+            break;
+        case 28:
+            for (int i = 0; i < 3; i++) {
+                ir[i] = static_cast<int16_t>(((value >> (i * 5)) & 0x1F) << 7);
+            }
+            break;
+        case 30: {
+            lzcs = value;
+            // Count leading bits equal to the sign bit
+            const uint32_t bits = static_cast<int32_t>(value) < 0 ? ~value : value;
+            lzcr = bits == 0 ? 32 : __builtin_clz(bits);
+            break;
+        }
+        default:
+            break;  // ORGB and LZCR are read-only
+    }
+}
+
+uint32_t GTE::readControl(uint32_t index) const {
+    switch (index & 0x1F) {
+        case 0: case 1: case 2: case 3: case 4:
+            return readMatrix(RT, index);
+        case 5: case 6: case 7:
+            return static_cast<uint32_t>(TR[index - 5]);
+        case 8: case 9: case 10: case 11: case 12:
+            return readMatrix(LLM, index - 8);
+        case 13: case 14: case 15:
+            return static_cast<uint32_t>(BK[index - 13]);
+        case 16: case 17: case 18: case 19: case 20:
+            return readMatrix(LCM, index - 16);
+        case 21: case 22: case 23:
+            return static_cast<uint32_t>(FC[index - 21]);
+        case 24: return static_cast<uint32_t>(ofx);
+        case 25: return static_cast<uint32_t>(ofy);
+        case 26: return static_cast<uint32_t>(static_cast<int32_t>(static_cast<int16_t>(h)));  // H reads sign-extended
+        case 27: return static_cast<uint32_t>(static_cast<int32_t>(dqa));
+        case 28: return static_cast<uint32_t>(dqb);
+        case 29: return static_cast<uint32_t>(static_cast<int32_t>(zsf3));
+        case 30: return static_cast<uint32_t>(static_cast<int32_t>(zsf4));
+        default: return flag;
+    }
+}
+
+void GTE::writeControl(uint32_t index, uint32_t value) {
+    switch (index & 0x1F) {
+        case 0: case 1: case 2: case 3: case 4:
+            writeMatrix(RT, index, value);
+            break;
+        case 5: case 6: case 7:
+            TR[index - 5] = static_cast<int32_t>(value);
+            break;
+        case 8: case 9: case 10: case 11: case 12:
+            writeMatrix(LLM, index - 8, value);
+            break;
+        case 13: case 14: case 15:
+            BK[index - 13] = static_cast<int32_t>(value);
+            break;
+        case 16: case 17: case 18: case 19: case 20:
+            writeMatrix(LCM, index - 16, value);
+            break;
+        case 21: case 22: case 23:
+            FC[index - 21] = static_cast<int32_t>(value);
+            break;
+        case 24: ofx = static_cast<int32_t>(value); break;
+        case 25: ofy = static_cast<int32_t>(value); break;
+        case 26: h = static_cast<uint16_t>(value); break;
+        case 27: dqa = static_cast<int16_t>(value); break;
+        case 28: dqb = static_cast<int32_t>(value); break;
+        case 29: zsf3 = static_cast<int16_t>(value); break;
+        case 30: zsf4 = static_cast<int16_t>(value); break;
+        default:
+            flag = value & FLAG_WRITABLE;
+            if (flag & FLAG_ERROR_SOURCES) flag |= FLAG_ERROR;
+            break;
+    }
+}
+
+// --- Arithmetic helpers ---
+
+int64_t GTE::transform(const int16_t m[3][3], const int16_t v[3], const int32_t t[3], bool sf, bool lm) {
+    Product p;
+    flag |= matVec(m, v, t, sf ? 12 : 0, lm, p);
+
+    for (int i = 0; i < 3; i++) {
+        mac[i] = p.mac[i];
+        ir[i] = static_cast<int16_t>(p.ir[i]);
+    }
+    return p.raw[2];
+}
+
+void GTE::setMac(int index, int64_t value, int shift) {
+    flag |= macOverflow(index, value);
+    mac[index] = static_cast<int32_t>(value >> shift);
+}
+
+void GTE::setIr(int index, int32_t value, bool lm) {
+    const int32_t clamped = std::clamp<int32_t>(value, lm ? 0 : -0x8000, 0x7FFF);
+    if (clamped != value) flag |= FLAG_IR1 >> index;
+    ir[index] = static_cast<int16_t>(clamped);
+}
+
+void GTE::setMacIr(int index, int64_t value, int shift, bool lm) {
+    setMac(index, value, shift);
+    setIr(index, mac[index], lm);
+}
+
+int64_t GTE::checkMac0(int64_t value) {
+    if (value > INT32_MAX) flag |= FLAG_MAC0_POS;
+    else if (value < INT32_MIN) flag |= FLAG_MAC0_NEG;
+    return value;
+}
+
+void GTE::setIr0(int32_t value) {
+    const int32_t clamped = std::clamp<int32_t>(value, 0, 0x1000);
+    if (clamped != value) flag |= FLAG_IR0;
+    ir0 = static_cast<int16_t>(clamped);
+}
+
+void GTE::pushSXY(int16_t x, int16_t y) {
+    sx[0] = sx[1]; sy[0] = sy[1];
+    sx[1] = sx[2]; sy[1] = sy[2];
+    sx[2] = x;     sy[2] = y;
+}
+
+void GTE::pushSZ(int32_t z) {
+    const int32_t clamped = std::clamp<int32_t>(z, 0, 0xFFFF);
+    if (clamped != z) flag |= FLAG_SZ_OTZ;
+
+    sz[0] = sz[1];
+    sz[1] = sz[2];
+    sz[2] = sz[3];
+    sz[3] = static_cast<uint16_t>(clamped);
+}
+
+void GTE::pushColor() {
+    uint32_t color = rgbc & 0xFF000000;
+    for (int i = 0; i < 3; i++) {
+        const int32_t value = mac[i] >> 4;
+        const int32_t clamped = std::clamp<int32_t>(value, 0, 0xFF);
+        if (clamped != value) flag |= FLAG_COLOR_R >> i;
+        color |= static_cast<uint32_t>(clamped) << (i * 8);
+    }
+
+    rgb[0] = rgb[1];
+    rgb[1] = rgb[2];
+    rgb[2] = color;
+}
+
+uint32_t GTE::divide(uint32_t lhs, uint32_t rhs) {
+    // Unsigned Newton-Raphson division as performed by the hardware
+    if (rhs * 2 <= lhs) {
+        flag |= FLAG_DIVIDE;
+        return 0x1FFFF;
+    }
+
+    const int shift = __builtin_clz(rhs) - 16;
+    const uint32_t n = lhs << shift;
+    const int32_t d = static_cast<int32_t>(rhs << shift);
+
+    const int32_t u = 0x101 + UNR_TABLE[((d & 0x7FFF) + 0x40) >> 7];
+    const int32_t e = ((d * -u) + 0x80) >> 8;
+    const uint32_t reciprocal = static_cast<uint32_t>(((u * (0x20000 + e)) + 0x80) >> 8);
+
+    return std::min<uint32_t>(0x1FFFF, static_cast<uint32_t>((static_cast<uint64_t>(n) * reciprocal + 0x8000) >> 16));
+}
+
+// --- Commands ---
+
+void GTE::execute(uint32_t command) {
+    const bool sf = command & (1u << 19);
+    const bool lm = command & (1u << 10);
+
+    flag = 0;
+
+    switch (command & 0x3F) {
+        case 0x01: rtp(0, sf, lm, true); break;                         // RTPS
+        case 0x06: nclip(); break;                                      // NCLIP
+        case 0x0C: op(sf, lm); break;                                   // OP
+        case 0x10: dpcs(rgbc, sf, lm); break;                           // DPCS
+        case 0x11: intpl(sf, lm); break;                                // INTPL
+        case 0x12: mvmva(command, sf, lm); break;                       // MVMVA
+        case 0x13: ncd(0, sf, lm); break;                               // NCDS
+        case 0x14: cdp(sf, lm); break;                                  // CDP
+        case 0x16: for (int i = 0; i < 3; i++) ncd(i, sf, lm); break;   // NCDT
+        case 0x1B: ncc(0, sf, lm); break;                               // NCCS
+        case 0x1C: cc(sf, lm); break;                                   // CC
+        case 0x1E: nc(0, sf, lm); break;                                // NCS
+        case 0x20: for (int i = 0; i < 3; i++) nc(i, sf, lm); break;    // NCT
+        case 0x28: sqr(sf, lm); break;                                  // SQR
+        case 0x29: dcpl(sf, lm); break;                                 // DCPL
+        case 0x2A: for (int i = 0; i < 3; i++) dpcs(rgb[0], sf, lm); break; // DPCT
+        case 0x2D: avsz3(); break;                                      // AVSZ3
+        case 0x2E: avsz4(); break;                                      // AVSZ4
+        case 0x30:                                                      // RTPT
+            rtp(0, sf, lm, false);
+            rtp(1, sf, lm, false);
+            rtp(2, sf, lm, true);
+            break;
+        case 0x3D: gpf(sf, lm); break;                                  // GPF
+        case 0x3E: gpl(sf, lm); break;                                  // GPL
+        case 0x3F: for (int i = 0; i < 3; i++) ncc(i, sf, lm); break;   // NCCT
+        default: break;
+    }
+
+    if (flag & FLAG_ERROR_SOURCES) flag |= FLAG_ERROR;
+}
+
+void GTE::rtp(int index, bool sf, bool lm, bool last) {
+    const int64_t z = transform(RT, V[index], TR, sf, lm);
+
+    // The IR3 flag follows MAC3 SAR 12 rather than the value IR3 is saturated from
+    const int32_t depth = static_cast<int32_t>(z >> 12);
+    flag &= ~(FLAG_IR1 >> 2);
+    if (depth < -0x8000 || depth > 0x7FFF) flag |= FLAG_IR1 >> 2;
+
+    pushSZ(depth);
+
+    const int64_t q = divide(h, sz[3]);
+    const int64_t x = checkMac0(q * ir[0] + ofx);
+    const int64_t y = checkMac0(q * ir[1] + ofy);
+    mac0 = static_cast<int32_t>(y);
+
+    const int32_t sx2 = std::clamp<int32_t>(static_cast<int32_t>(x >> 16), -0x400, 0x3FF);
+    const int32_t sy2 = std::clamp<int32_t>(static_cast<int32_t>(y >> 16), -0x400, 0x3FF);
+    if (sx2 != static_cast<int32_t>(x >> 16)) flag |= FLAG_SX2;
+    if (sy2 != static_cast<int32_t>(y >> 16)) flag |= FLAG_SY2;
+    pushSXY(static_cast<int16_t>(sx2), static_cast<int16_t>(sy2));
+
+    if (last) {
+        const int64_t depth_cue = checkMac0(q * dqa + dqb);
+        mac0 = static_cast<int32_t>(depth_cue);
+        setIr0(static_cast<int32_t>(depth_cue >> 12));
+    }
+}
+
+void GTE::nclip() {
+    const int64_t value =
+        static_cast<int64_t>(sx[0]) * sy[1] + static_cast<int64_t>(sx[1]) * sy[2] + static_cast<int64_t>(sx[2]) * sy[0] -
+        static_cast<int64_t>(sx[0]) * sy[2] - static_cast<int64_t>(sx[1]) * sy[0] - static_cast<int64_t>(sx[2]) * sy[1];
+    mac0 = static_cast<int32_t>(checkMac0(value));
+}
+
+void GTE::op(bool sf, bool lm) {
+    const int shift = sf ? 12 : 0;
+    const int64_t d1 = RT[0][0], d2 = RT[1][1], d3 = RT[2][2];
+
+    setMac(0, ir[2] * d2 - ir[1] * d3, shift);
+    setMac(1, ir[0] * d3 - ir[2] * d1, shift);
+    setMac(2, ir[1] * d1 - ir[0] * d2, shift);
+    for (int i = 0; i < 3; i++) {
+        setIr(i, mac[i], lm);
+    }
+}
+
+void GTE::mvmva(uint32_t command, bool sf, bool lm) {
+    const uint32_t mx = (command >> 17) & 3;
+    const uint32_t vx = (command >> 15) & 3;
+    const uint32_t tx = (command >> 13) & 3;
+
+    // Matrix 3 selects a garbage matrix built from RGBC, IR0 and RT
+    const int16_t r = static_cast<int16_t>(colorComponent(rgbc, 0) << 4);
+    const int16_t garbage[3][3] = {
+        {static_cast<int16_t>(-r), r, ir0},
+        {RT[0][2], RT[0][2], RT[0][2]},
+        {RT[1][1], RT[1][1], RT[1][1]},
+    };
+    const int16_t (*m)[3] = mx == 0 ? RT : mx == 1 ? LLM : mx == 2 ? LCM : garbage;
+
+    int16_t v[3];
+    std::memcpy(v, vx == 3 ? ir : V[vx], sizeof(v));
+
+    const int32_t* t = tx == 0 ? TR : tx == 1 ? BK : tx == 2 ? FC : ZERO_VECTOR;
+
+    if (tx != 2) {
+        transform(m, v, t, sf, lm);
+        return;
+    }
+
+    // Far colour translation is bugged: the first column only affects the flags
+    const int shift = sf ? 12 : 0;
+    for (int i = 0; i < 3; i++) {
+        const int64_t first = (static_cast<int64_t>(FC[i]) << 12) + static_cast<int32_t>(m[i][0]) * v[0];
+        flag |= macOverflow(i, first);
+        setIr(i, static_cast<int32_t>(signExtend44(first) >> shift), false);
+    }
+    for (int i = 0; i < 3; i++) {
+        const int64_t partial = static_cast<int64_t>(m[i][1]) * v[1];
+        flag |= macOverflow(i, partial);
+        setMacIr(i, signExtend44(partial) + static_cast<int64_t>(m[i][2]) * v[2], shift, lm);
+    }
+}
+
+void GTE::interpolate(int64_t m1, int64_t m2, int64_t m3, bool sf, bool lm) {
+    // MAC = MAC + (FC - MAC) * IR0
+    const int shift = sf ? 12 : 0;
+    const int64_t in[3] = {m1, m2, m3};
+
+    for (int i = 0; i < 3; i++) {
+        setMacIr(i, (static_cast<int64_t>(FC[i]) << 12) - in[i], shift, false);
+    }
+    for (int i = 0; i < 3; i++) {
+        setMacIr(i, static_cast<int64_t>(ir[i]) * ir0 + in[i], shift, lm);
+    }
+}
+
+void GTE::light(int index, bool sf, bool lm) {
+    // IR = LLM * V, then IR = BK + LCM * IR
+    transform(LLM, V[index], ZERO_VECTOR, sf, lm);
+    colorMatrix(sf, lm);
+}
+
+void GTE::colorMatrix(bool sf, bool lm) {
+    int16_t v[3];
+    std::memcpy(v, ir, sizeof(v));
+    transform(LCM, v, BK, sf, lm);
+}
+
+void GTE::colorScale(bool sf, bool lm) {
+    // MAC = (RGB * IR) SHL 4, SAR (sf * 12)
+    const int shift = sf ? 12 : 0;
+    for (int i = 0; i < 3; i++) {
+        setMacIr(i, (static_cast<int64_t>(colorComponent(rgbc, i)) * ir[i]) << 4, shift, lm);
+    }
+}
+
+void GTE::depthCue(bool sf, bool lm) {
+    interpolate((static_cast<int64_t>(colorComponent(rgbc, 0)) * ir[0]) << 4,
+                (static_cast<int64_t>(colorComponent(rgbc, 1)) * ir[1]) << 4,
+                (static_cast<int64_t>(colorComponent(rgbc, 2)) * ir[2]) << 4, sf, lm);
+}
+
+void GTE::dpcs(uint32_t color, bool sf, bool lm) {
+    interpolate(static_cast<int64_t>(colorComponent(color, 0)) << 16,
+                static_cast<int64_t>(colorComponent(color, 1)) << 16,
+                static_cast<int64_t>(colorComponent(color, 2)) << 16, sf, lm);
+    pushColor();
+}
+
+void GTE::dcpl(bool sf, bool lm) {
+    depthCue(sf, lm);
+    pushColor();
+}
+
+void GTE::intpl(bool sf, bool lm) {
+    interpolate(static_cast<int64_t>(ir[0]) << 12, static_cast<int64_t>(ir[1]) << 12,
+                static_cast<int64_t>(ir[2]) << 12, sf, lm);
+    pushColor();
+}
+
+void GTE::sqr(bool sf, bool lm) {
+    const int shift = sf ? 12 : 0;
+    for (int i = 0; i < 3; i++) {
+        setMacIr(i, static_cast<int64_t>(ir[i]) * ir[i], shift, lm);
+    }
+}
+
+void GTE::nc(int index, bool sf, bool lm) {
+    light(index, sf, lm);
+    pushColor();
+}
+
+void GTE::ncc(int index, bool sf, bool lm) {
+    light(index, sf, lm);
+    colorScale(sf, lm);
+    pushColor();
+}
+
+void GTE::ncd(int index, bool sf, bool lm) {
+    light(index, sf, lm);
+    depthCue(sf, lm);
+    pushColor();
+}
+
+void GTE::cc(bool sf, bool lm) {
+    colorMatrix(sf, lm);
+    colorScale(sf, lm);
+    pushColor();
+}
+
+void GTE::cdp(bool sf, bool lm) {
+    colorMatrix(sf, lm);
+    depthCue(sf, lm);
+    pushColor();
+}
+
+void GTE::avsz3() {
+    const int64_t value = checkMac0(static_cast<int64_t>(zsf3) * (sz[1] + sz[2] + sz[3]));
+    mac0 = static_cast<int32_t>(value);
+
+    const int64_t clamped = std::clamp<int64_t>(value >> 12, 0, 0xFFFF);
+    if (clamped != (value >> 12)) flag |= FLAG_SZ_OTZ;
+    otz = static_cast<uint16_t>(clamped);
+}
+
+void GTE::avsz4() {
+    const int64_t value = checkMac0(static_cast<int64_t>(zsf4) * (sz[0] + sz[1] + sz[2] + sz[3]));
+    mac0 = static_cast<int32_t>(value);
+
+    const int64_t clamped = std::clamp<int64_t>(value >> 12, 0, 0xFFFF);
+    if (clamped != (value >> 12)) flag |= FLAG_SZ_OTZ;
+    otz = static_cast<uint16_t>(clamped);
+}
+
+void GTE::gpf(bool sf, bool lm) {
+    // MAC = IR * IR0
+    const int shift = sf ? 12 : 0;
+    for (int i = 0; i < 3; i++) {
+        setMacIr(i, static_cast<int64_t>(ir[i]) * ir0, shift, lm);
+    }
+    pushColor();
+}
+
+void GTE::gpl(bool sf, bool lm) {
+    // MAC = MAC + IR * IR0
+    const int shift = sf ? 12 : 0;
+    for (int i = 0; i < 3; i++) {
+        setMacIr(i, (static_cast<int64_t>(mac[i]) << shift) + static_cast<int64_t>(ir[i]) * ir0, shift, lm);
+    }
+    pushColor();
+}
@@ -7,10 +7,27 @@
 #include <iostream>
 #include <chrono>
 #include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 #include "bus.hpp"
 #include "cpu.hpp"
+#include "dma.hpp"
+#include "timers.hpp"
+#include "gpu.hpp"
+#include "video_output.hpp"
+#include "spu.hpp"
+#include "audio_output.hpp"
+#include "mdec.hpp"
+#include "cdrom.hpp"
+#include "sio.hpp"
+#include "controller.hpp"
+#include "memory_card.hpp"
 #include "opcodes.hpp"
+#include "run_loop.hpp"
+#include "debugger.hpp"
 
 volatile std::sig_atomic_t g_signal_received = 0;
 void signal_handler(int signal) { g_signal_received = signal; }
@@ -21,8 +38,54 @@ int main(int argc, char* argv[]) {
     std::cout << "[Profiler] Profiler initialized" << std::endl;
 #endif
 
-    if (argc < 2) {
-        std::cerr << "Usage: "<< argv[0] << " <bios_file> <rom_file>" << std::endl;
+    // Positional: BIOS, then an optional disc image. Options may appear anywhere.
+    const char* bios_path = nullptr;
+    const char* disc_path = nullptr;
+    SpeedMode speed = SpeedMode::RealTime;
+    unsigned ff_factor = 1;
+    uint64_t frame_limit = 0;
+    std::vector<uint32_t> breakpoints;
+    std::vector<Watchpoint> watchpoints;
+    const char* card_paths[2] = {nullptr, nullptr};
+    bool usage_error = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--uncapped") == 0) {
+            speed = SpeedMode::Uncapped;
+        } else if (std::strcmp(argv[i], "--fast-forward") == 0 && i + 1 < argc) {
+            speed = SpeedMode::FastForward;
+            ff_factor = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+            usage_error |= ff_factor < 2;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frame_limit = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--memcard1") == 0 && i + 1 < argc) {
+            card_paths[0] = argv[++i];
+        } else if (std::strcmp(argv[i], "--memcard2") == 0 && i + 1 < argc) {
+            card_paths[1] = argv[++i];
+        } else if (std::strcmp(argv[i], "--break") == 0 && i + 1 < argc) {
+            breakpoints.push_back(static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 0)));
+        } else if ((std::strcmp(argv[i], "--watch") == 0 || std::strcmp(argv[i], "--watch-read") == 0) && i + 1 < argc) {
+            // ADDR[:SIZE], SIZE defaulting to one word
+            const WatchKind kind = std::strcmp(argv[i], "--watch-read") == 0 ? WatchKind::Read : WatchKind::Write;
+            char* end = nullptr;
+            const uint32_t address = static_cast<uint32_t>(std::strtoul(argv[++i], &end, 0));
+            const uint32_t size = (*end == ':') ? static_cast<uint32_t>(std::strtoul(end + 1, nullptr, 0)) : 4;
+            watchpoints.push_back({address, size, kind});
+        } else if (argv[i][0] == '-') {
+            usage_error = true;
+        } else if (!bios_path) {
+            bios_path = argv[i];
+        } else if (!disc_path) {
+            disc_path = argv[i];
+        } else {
+            usage_error = true;
+        }
+    }
+
+    if (!bios_path || usage_error) {
+        std::cerr << "Usage: "<< argv[0] << " <bios_file> [disc_image] [--uncapped | --fast-forward N] [--frames N]"
+                  << " [--memcard1 FILE] [--memcard2 FILE]"
+                  << " [--break ADDR] [--watch ADDR[:SIZE]] [--watch-read ADDR[:SIZE]]" << std::endl;
         return 1;
     }
 
@@ -30,19 +93,93 @@ int main(int argc, char* argv[]) {
 
     Bus bus;
     CPU cpu(&bus);
+    DMA dma(&bus);
+    Timers timers(&bus);
+    VideoOutput video;
+    GPU gpu(&bus);
+    // Declared before the SPU so the audio thread is gone before the device closes
+    AudioOutput audio;
+    SPU spu(&bus);
+    MDEC mdec(&bus);
+    CDROM cdrom(&bus);
+    SIO sio(&bus);
+    DigitalPad pad;
+    // Cards flush on close, when they go out of scope
+    MemoryCard cards[2];
 
     bus.init();
+    dma.init();
+    timers.init();
+    gpu.init();
+    spu.init();
+    mdec.init();
+    cdrom.init();
+    sio.init();
+    const unsigned cores = std::thread::hardware_concurrency();
+    gpu.setThreaded(cores > 1);
+    // Cores left over after the CPU and render threads rasterize VRAM tiles and
+    // decode MDEC macroblocks
+    if (cores > 3) {
+        gpu.setTileThreads(cores - 2);
+        mdec.setDecodeThreads(cores - 2);
+    }
+    // Headless runs (no display) keep the GPU's null frame sink
+    video.open();
+    // Without an audio device the SPU keeps its null sink and mixes into nothing
+    if (audio.open()) {
+        spu.connectAudio(audio.sink());
+    }
+    spu.setThreaded(cores > 1);
+    gpu.connectTimers(&timers);
+    dma.connect(DMAChannel::GPU, gpu.dmaPort());
+    dma.connect(DMAChannel::SPU, spu.dmaPort());
+    dma.connect(DMAChannel::MDECin, mdec.dmaInPort());
+    dma.connect(DMAChannel::MDECout, mdec.dmaOutPort());
+    dma.connect(DMAChannel::CDROM, cdrom.dmaPort());
+    bus.connectDMA(&dma);
+    bus.connectTimers(&timers);
+    bus.connectGPU(&gpu);
+    bus.connectSPU(&spu);
+    bus.connectMDEC(&mdec);
+    bus.connectCDROM(&cdrom);
+    bus.connectSIO(&sio);
+
+    sio.connectPad(0, &pad);
+    for (int slot = 0; slot < 2; slot++) {
+        // A card that fails to open leaves its slot empty
+        if (card_paths[slot] && cards[slot].open(card_paths[slot])) {
+            sio.connectCard(slot, &cards[slot]);
+        }
+    }
     
-    if (!bus.loadBIOS(argv[1])) {
+    if (!bus.loadBIOS(bios_path)) {
         return 1;
     }
 
+    if (disc_path) {
+        std::unique_ptr<DiscImage> disc = DiscImage::open(disc_path);
+        if (!disc) {
+            return 1;
+        }
+        cdrom.insertDisc(std::move(disc));
+    }
+
     cpu.init();
     init_opcodes(cpu);
 
-    while (g_signal_received == 0) {
-        cpu.step();
+    // Only connected when used: the bus consults it for diverted pages alone
+    Debugger debugger(&bus, &cpu);
+    if (!breakpoints.empty() || !watchpoints.empty()) {
+        bus.connectDebugger(&debugger);
+        for (uint32_t address : breakpoints) debugger.addBreakpoint(address);
+        for (const Watchpoint& w : watchpoints) debugger.addWatchpoint(w.start, w.size, w.kind);
     }
+
+    RunLoop loop(&bus, &cpu, &gpu, &video);
+    loop.connectPad(&pad);
+    loop.setMode(speed, ff_factor);
+    loop.setFrameLimit(frame_limit);
+    loop.run(g_signal_received);
     
     cpu.bus->dumpMemoryRegion(cpu.registers.pc, 0x100);
 
@@ -0,0 +1,44 @@
+/*
+    Description: MDEC Macroblock Kernels Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// Per-block kernels behind the MDEC: the two-pass IDCT and the YUV to RGB
+// conversion of a whole 16x16 macroblock. RLE decoding is a serial bitstream
+// walk and stays in the MDEC itself.
+namespace Macroblock {
+
+    constexpr int BLOCK_COEFFS = 64;
+
+    // Colour macroblocks arrive as Cr, Cb, Y1, Y2, Y3, Y4 (Y blocks in raster order)
+    constexpr int COLOUR_BLOCKS = 6;
+
+    // IDCT matrix as uploaded by command 3 (row = frequency, column = position),
+    // kept alongside its transpose so both passes read rows.
+    struct IDCTTable {
+        alignas(32) int16_t rows[BLOCK_COEFFS];
+        alignas(32) int16_t transposed[BLOCK_COEFFS];
+
+        void set(const int16_t* matrix);
+    };
+
+    // Two-pass fixed point IDCT of one block of dequantised coefficients
+    // (natural order). Each pass rounds away 16 fractional bits and saturates
+    // to 16 bits; the result is clamped to signed 8 bits.
+    void idct(const int16_t* coeffs, const IDCTTable& table, int16_t* out);
+
+    // Convert a colour macroblock (COLOUR_BLOCKS IDCT outputs back to back)
+    // into 16x16 pixels, row by row. Unsigned output flips the sign bit of
+    // each 8-bit component.
+    void toRGB15(const int16_t* blocks, uint16_t* out, bool is_signed, bool set_bit15);
+    void toRGB24(const int16_t* blocks, uint8_t* out, bool is_signed);
+
+    // Name of the kernels compiled into this build (scalar / sse2 / avx2)
+    const char* backend();
+
+}
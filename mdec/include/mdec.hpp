@@ -0,0 +1,114 @@
+/*
+    Description: MDEC (Macroblock Decoder) Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dma.hpp"
+#include "macroblock.hpp"
+
+class Bus;
+
+// DMA0 only collects the RLE stream of a decode command; the macroblock
+// boundaries are found with a quick scan once the last parameter word arrives.
+// Decoding is deferred until the output is read: a DMA1 transfer decodes every
+// whole macroblock it covers straight into main RAM, spreading the macroblocks
+// over the worker pool. Partial reads (and MDEC_DATA reads) go through a
+// single macroblock spill buffer.
+class MDEC {
+    public:
+        MDEC(Bus* bus);
+        ~MDEC();
+
+        void init();
+
+        // Register interface (offset relative to 0x1F801820)
+        uint32_t read32(uint32_t offset);
+        void write32(uint32_t offset, uint32_t data);
+
+        // Decode macroblocks on `count` threads (the caller plus count - 1 workers)
+        void setDecodeThreads(unsigned count);
+
+        // DMA channel 0 / 1 endpoints
+        DMAPort dmaInPort();
+        DMAPort dmaOutPort();
+
+    private:
+        enum class Depth : uint8_t { Mono4 = 0, Mono8 = 1, RGB24 = 2, RGB15 = 3 };
+
+        // Largest macroblock output (16x16 pixels at 24 bits)
+        static constexpr uint32_t MAX_MACROBLOCK_BYTES = 16 * 16 * 3;
+
+        static void dmaToDevice(void* ctx, const uint32_t* words, uint32_t count);
+        static void dmaFromDevice(void* ctx, uint32_t* words, uint32_t count);
+
+        void reset();
+        void writeCommand(uint32_t word);
+        void receive(const uint32_t* words, uint32_t count);
+        void execute();
+        uint32_t status() const;
+
+        // --- Output ---
+        void readOutput(uint8_t* dst, uint32_t bytes);
+        void readSpill(uint8_t* dst, uint32_t bytes);
+        uint32_t macroblockBytes() const;
+        uint32_t outputBytes() const { return static_cast<uint32_t>(macroblocks.size()) * macroblockBytes(); }
+
+        // --- Decoding ---
+        void scanMacroblocks();
+        void decodeRange(uint32_t first, uint32_t count, uint8_t* dst);
+        void decodeMacroblock(uint32_t index, uint8_t* dst) const;
+        void decodeBlock(const uint16_t*& src, const uint8_t* quant, int16_t* out) const;
+
+        // --- Worker pool ---
+        void runJobs();
+        void workerLoop(uint64_t seen);
+        void stopWorkers();
+
+        Bus* bus = nullptr;
+
+        // Current command
+        uint32_t command = 0;
+        uint32_t params_remaining = 0;
+        std::vector<uint32_t> params;
+        bool dma_in_enabled = false;
+        bool dma_out_enabled = false;
+
+        // Output format of the last decode command
+        Depth depth = Depth::Mono4;
+        bool is_signed = false;
+        bool set_bit15 = false;
+
+        // Tables (command 2 / 3)
+        std::array<uint8_t, 64> luma_quant;
+        std::array<uint8_t, 64> chroma_quant;
+        Macroblock::IDCTTable idct_table;
+
+        // Halfword offsets of each complete macroblock in the RLE stream
+        std::vector<uint32_t> macroblocks;
+        uint32_t output_pos = 0;    // Bytes of output consumed
+
+        alignas(4) std::array<uint8_t, MAX_MACROBLOCK_BYTES> spill;
+        uint32_t spill_index = UINT32_MAX;
+
+        // Worker pool
+        std::vector<std::thread> workers;
+        std::mutex pool_mutex;
+        std::condition_variable start_cv, done_cv;
+        uint64_t generation = 0;
+        unsigned busy_workers = 0;
+        bool quit = false;
+        std::atomic<uint32_t> next_job{0};
+        uint32_t job_first = 0, job_count = 0;
+        uint8_t* job_dst = nullptr;
+};
@@ -0,0 +1,418 @@
+/*
+    Description: MDEC Macroblock Kernels Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "macroblock.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MB_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define MB_SSE2 1
+#endif
+
+namespace Macroblock {
+
+namespace {
+
+    constexpr int N = 8;
+    constexpr int MB_SIZE = 16;
+
+    // Each IDCT pass keeps 16 fractional bits of the matrix product
+    constexpr uint32_t ROUND = 0x8000;
+
+    // YUV -> RGB in 8.8 fixed point (1.402, -0.3437, -0.7143, 1.772)
+    constexpr int32_t CR_TO_R = 359;
+    constexpr int32_t CB_TO_G = -88;
+    constexpr int32_t CR_TO_G = -183;
+    constexpr int32_t CB_TO_B = 454;
+
+    inline int16_t saturate16(int32_t x) {
+        return static_cast<int16_t>(std::clamp<int32_t>(x, -0x8000, 0x7FFF));
+    }
+
+    inline const int16_t* lumaBlock(const int16_t* blocks, int y, int x) {
+        return blocks + (2 + (y / N) * 2 + (x / N)) * BLOCK_COEFFS;
+    }
+
+    // --- Scalar reference kernels ---
+
+    // out[i][x] = sum_z a[i][z] * b[z][x], in wrapping 32-bit arithmetic like pmaddwd
+    [[maybe_unused]] void passScalar(const int16_t* a, const int16_t* b, int16_t* out) {
+        for (int i = 0; i < N; i++) {
+            for (int x = 0; x < N; x++) {
+                uint32_t sum = ROUND;
+                for (int z = 0; z < N; z++) {
+                    sum += static_cast<uint32_t>(a[i * N + z] * b[z * N + x]);
+                }
+                out[i * N + x] = saturate16(static_cast<int32_t>(sum) >> 16);
+            }
+        }
+    }
+
+    [[maybe_unused]] void idctScalar(const int16_t* coeffs, const IDCTTable& table, int16_t* out) {
+        int16_t tmp[BLOCK_COEFFS];
+        passScalar(coeffs, table.rows, tmp);
+        passScalar(table.transposed, tmp, out);
+        for (int i = 0; i < BLOCK_COEFFS; i++) {
+            out[i] = static_cast<int16_t>(std::clamp<int16_t>(out[i], -128, 127));
+        }
+    }
+
+    // Per chroma sample contributions to R, G and B
+    [[maybe_unused]] void chromaTermsScalar(const int16_t* cr, const int16_t* cb,
+                                            int16_t* r, int16_t* g, int16_t* b) {
+        for (int i = 0; i < BLOCK_COEFFS; i++) {
+            r[i] = static_cast<int16_t>((cr[i] * CR_TO_R + 128) >> 8);
+            g[i] = static_cast<int16_t>((cb[i] * CB_TO_G + cr[i] * CR_TO_G + 128) >> 8);
+            b[i] = static_cast<int16_t>((cb[i] * CB_TO_B + 128) >> 8);
+        }
+    }
+
+    inline uint32_t component(int32_t y, int32_t term, int32_t flip) {
+        return static_cast<uint32_t>((std::clamp<int32_t>(y + term, -128, 127) ^ flip) & 0xFF);
+    }
+
+    [[maybe_unused]] void toRGB15Scalar(const int16_t* blocks, uint16_t* out, bool is_signed, bool set_bit15) {
+        int16_t rt[BLOCK_COEFFS], gt[BLOCK_COEFFS], bt[BLOCK_COEFFS];
+        chromaTermsScalar(blocks, blocks + BLOCK_COEFFS, rt, gt, bt);
+
+        const int32_t flip = is_signed ? 0 : 0x80;
+        for (int y = 0; y < MB_SIZE; y++) {
+            for (int x = 0; x < MB_SIZE; x++) {
+                const int32_t luma = lumaBlock(blocks, y, x)[(y % N) * N + (x % N)];
+                const int c = (y / 2) * N + (x / 2);
+                const uint32_t r = component(luma, rt[c], flip) >> 3;
+                const uint32_t g = component(luma, gt[c], flip) >> 3;
+                const uint32_t b = component(luma, bt[c], flip) >> 3;
+                out[y * MB_SIZE + x] = static_cast<uint16_t>(r | (g << 5) | (b << 10) | (set_bit15 ? 0x8000 : 0));
+            }
+        }
+    }
+
+    [[maybe_unused]] void toRGB24Scalar(const int16_t* blocks, uint8_t* out, bool is_signed) {
+        int16_t rt[BLOCK_COEFFS], gt[BLOCK_COEFFS], bt[BLOCK_COEFFS];
+        chromaTermsScalar(blocks, blocks + BLOCK_COEFFS, rt, gt, bt);
+
+        const int32_t flip = is_signed ? 0 : 0x80;
+        for (int y = 0; y < MB_SIZE; y++) {
+            for (int x = 0; x < MB_SIZE; x++) {
+                const int32_t luma = lumaBlock(blocks, y, x)[(y % N) * N + (x % N)];
+                const int c = (y / 2) * N + (x / 2);
+                uint8_t* px = out + (y * MB_SIZE + x) * 3;
+                px[0] = static_cast<uint8_t>(component(luma, rt[c], flip));
+                px[1] = static_cast<uint8_t>(component(luma, gt[c], flip));
+                px[2] = static_cast<uint8_t>(component(luma, bt[c], flip));
+            }
+        }
+    }
+
+#if defined(MB_AVX2) || defined(MB_SSE2)
+
+    inline __m128i load128(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+    inline void store128(void* p, __m128i v) { _mm_storeu_si128(static_cast<__m128i*>(p), v); }
+
+    // Two adjacent coefficients of row i, broadcast as one pmaddwd operand
+    inline int32_t pairAt(const int16_t* a, int i, int p) {
+        int32_t pair;
+        std::memcpy(&pair, a + i * N + p * 2, sizeof(pair));
+        return pair;
+    }
+
+    // 64 values, so the SSE2 version serves the AVX2 build as well
+    void chromaTermsSIMD(const int16_t* cr, const int16_t* cb, int16_t* r, int16_t* g, int16_t* b) {
+        auto pairConst = [](int32_t lo, int32_t hi) {
+            return _mm_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(hi & 0xFFFF) << 16) | (lo & 0xFFFF)));
+        };
+        const __m128i kr = pairConst(0, CR_TO_R);
+        const __m128i kg = pairConst(CB_TO_G, CR_TO_G);
+        const __m128i kb = pairConst(CB_TO_B, 0);
+        const __m128i round = _mm_set1_epi32(128);
+
+        auto term = [&](__m128i lo, __m128i hi, __m128i k) {
+            const __m128i a = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(lo, k), round), 8);
+            const __m128i b = _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(hi, k), round), 8);
+            return _mm_packs_epi32(a, b);
+        };
+
+        for (int i = 0; i < BLOCK_COEFFS; i += 8) {
+            // (Cb, Cr) pairs
+            const __m128i vb = load128(cb + i);
+            const __m128i vr = load128(cr + i);
+            const __m128i lo = _mm_unpacklo_epi16(vb, vr);
+            const __m128i hi = _mm_unpackhi_epi16(vb, vr);
+            store128(r + i, term(lo, hi, kr));
+            store128(g + i, term(lo, hi, kg));
+            store128(b + i, term(lo, hi, kb));
+        }
+    }
+
+#endif
+
+#if defined(MB_AVX2)
+
+    // One IDCT pass; b's rows are interleaved in pairs so a single pmaddwd
+    // covers two steps of the dot product for all eight columns.
+    void passAVX2(const int16_t* a, const int16_t* b, int16_t* out) {
+        __m256i pairs[N / 2];
+        for (int p = 0; p < N / 2; p++) {
+            const __m128i r0 = load128(b + (p * 2) * N);
+            const __m128i r1 = load128(b + (p * 2 + 1) * N);
+            pairs[p] = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(r0, r1)),
+                                               _mm_unpackhi_epi16(r0, r1), 1);
+        }
+
+        const __m256i round = _mm256_set1_epi32(ROUND);
+        for (int i = 0; i < N; i += 2) {
+            __m256i acc0 = round;
+            __m256i acc1 = round;
+            for (int p = 0; p < N / 2; p++) {
+                acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(_mm256_set1_epi32(pairAt(a, i, p)), pairs[p]));
+                acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(_mm256_set1_epi32(pairAt(a, i + 1, p)), pairs[p]));
+            }
+            // packs works per 128-bit lane: restore row order afterwards
+            __m256i packed = _mm256_packs_epi32(_mm256_srai_epi32(acc0, 16), _mm256_srai_epi32(acc1, 16));
+            packed = _mm256_permute4x64_epi64(packed, 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * N), packed);
+        }
+    }
+
+    void idctSIMD(const int16_t* coeffs, const IDCTTable& table, int16_t* out) {
+        alignas(32) int16_t tmp[BLOCK_COEFFS];
+        passAVX2(coeffs, table.rows, tmp);
+        passAVX2(table.transposed, tmp, out);
+
+        const __m256i lo = _mm256_set1_epi16(-128);
+        const __m256i hi = _mm256_set1_epi16(127);
+        for (int i = 0; i < BLOCK_COEFFS; i += 16) {
+            __m256i* p = reinterpret_cast<__m256i*>(out + i);
+            _mm256_storeu_si256(p, _mm256_min_epi16(_mm256_max_epi16(_mm256_loadu_si256(p), lo), hi));
+        }
+    }
+
+    // The 16 pixels of one macroblock row as unsigned 8-bit components
+    struct Row {
+        __m256i r, g, b;
+    };
+
+    inline Row rowAVX2(const int16_t* blocks, const int16_t* rt, const int16_t* gt, const int16_t* bt,
+                       int y, __m256i flip) {
+        const int16_t* left = lumaBlock(blocks, y, 0) + (y % N) * N;
+        const int16_t* right = lumaBlock(blocks, y, N) + (y % N) * N;
+        const __m256i luma = _mm256_inserti128_si256(_mm256_castsi128_si256(load128(left)), load128(right), 1);
+
+        const int c = (y / 2) * N;
+        auto channel = [&](const int16_t* terms) {
+            const __m128i t = load128(terms + c);
+            const __m256i dup = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(t, t)),
+                                                        _mm_unpackhi_epi16(t, t), 1);
+            __m256i v = _mm256_add_epi16(luma, dup);
+            v = _mm256_min_epi16(_mm256_max_epi16(v, _mm256_set1_epi16(-128)), _mm256_set1_epi16(127));
+            return _mm256_and_si256(_mm256_xor_si256(v, flip), _mm256_set1_epi16(0xFF));
+        };
+        return {channel(rt), channel(gt), channel(bt)};
+    }
+
+    void toRGB15SIMD(const int16_t* blocks, uint16_t* out, bool is_signed, bool set_bit15) {
+        alignas(16) int16_t rt[BLOCK_COEFFS], gt[BLOCK_COEFFS], bt[BLOCK_COEFFS];
+        chromaTermsSIMD(blocks, blocks + BLOCK_COEFFS, rt, gt, bt);
+
+        const __m256i flip = _mm256_set1_epi16(is_signed ? 0 : 0x80);
+        const __m256i bit15 = _mm256_set1_epi16(static_cast<int16_t>(set_bit15 ? 0x8000 : 0));
+        for (int y = 0; y < MB_SIZE; y++) {
+            const Row row = rowAVX2(blocks, rt, gt, bt, y, flip);
+            __m256i px = _mm256_srli_epi16(row.r, 3);
+            px = _mm256_or_si256(px, _mm256_slli_epi16(_mm256_srli_epi16(row.g, 3), 5));
+            px = _mm256_or_si256(px, _mm256_slli_epi16(_mm256_srli_epi16(row.b, 3), 10));
+            px = _mm256_or_si256(px, bit15);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + y * MB_SIZE), px);
+        }
+    }
+
+    void toRGB24SIMD(const int16_t* blocks, uint8_t* out, bool is_signed) {
+        alignas(16) int16_t rt[BLOCK_COEFFS], gt[BLOCK_COEFFS], bt[BLOCK_COEFFS];
+        chromaTermsSIMD(blocks, blocks + BLOCK_COEFFS, rt, gt, bt);
+
+        const __m256i flip = _mm256_set1_epi16(is_signed ? 0 : 0x80);
+        alignas(32) uint32_t px[MB_SIZE];
+        for (int y = 0; y < MB_SIZE; y++) {
+            const Row row = rowAVX2(blocks, rt, gt, bt, y, flip);
+
+            // 0x00BBGGRR per pixel; the 64-bit shuffle keeps unpack from mixing lanes
+            const __m256i rg = _mm256_permute4x64_epi64(_mm256_or_si256(row.r, _mm256_slli_epi16(row.g, 8)), 0xD8);
+            const __m256i b = _mm256_permute4x64_epi64(row.b, 0xD8);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(px), _mm256_unpacklo_epi16(rg, b));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(px + 8), _mm256_unpackhi_epi16(rg, b));
+
+            uint8_t* dst = out + y * MB_SIZE * 3;
+            for (int x = 0; x < MB_SIZE; x++) {
+                std::memcpy(dst + x * 3, &px[x], 3);
+            }
+        }
+    }
+
+#elif defined(MB_SSE2)
+
+    void passSSE2(const int16_t* a, const int16_t* b, int16_t* out) {
+        __m128i lo[N / 2], hi[N / 2];
+        for (int p = 0; p < N / 2; p++) {
+            const __m128i r0 = load128(b + (p * 2) * N);
+            const __m128i r1 = load128(b + (p * 2 + 1) * N);
+            lo[p] = _mm_unpacklo_epi16(r0, r1);
+            hi[p] = _mm_unpackhi_epi16(r0, r1);
+        }
+
+        const __m128i round = _mm_set1_epi32(ROUND);
+        for (int i = 0; i < N; i++) {
+            __m128i acc_lo = round;
+            __m128i acc_hi = round;
+            for (int p = 0; p < N / 2; p++) {
+                const __m128i w = _mm_set1_epi32(pairAt(a, i, p));
+                acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(w, lo[p]));
+                acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(w, hi[p]));
+            }
+            store128(out + i * N, _mm_packs_epi32(_mm_srai_epi32(acc_lo, 16), _mm_srai_epi32(acc_hi, 16)));
+        }
+    }
+
+    void idctSIMD(const int16_t* coeffs, const IDCTTable& table, int16_t* out) {
+        alignas(16) int16_t tmp[BLOCK_COEFFS];
+        passSSE2(coeffs, table.rows, tmp);
+        passSSE2(table.transposed, tmp, out);
+
+        const __m128i lo = _mm_set1_epi16(-128);
+        const __m128i hi = _mm_set1_epi16(127);
+        for (int i = 0; i < BLOCK_COEFFS; i += 8) {
+            store128(out + i, _mm_min_epi16(_mm_max_epi16(load128(out + i), lo), hi));
+        }
+    }
+
+    // Eight pixels of one 8x8 luma block row as unsigned 8-bit components
+    struct Row {
+        __m128i r, g, b;
+    };
+
+    inline Row rowSSE2(const int16_t* blocks, const int16_t* rt, const int16_t* gt, const int16_t* bt,
+                       int y, int x, __m128i flip) {
+        const __m128i luma = load128(lumaBlock(blocks, y, x) + (y % N) * N);
+
+        const int c = (y / 2) * N + x / 2;
+        auto channel = [&](const int16_t* terms) {
+            const __m128i t = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(terms + c));
+            __m128i v = _mm_add_epi16(luma, _mm_unpacklo_epi16(t, t));
+            v = _mm_min_epi16(_mm_max_epi16(v, _mm_set1_epi16(-128)), _mm_set1_epi16(127));
+            return _mm_and_si128(_mm_xor_si128(v, flip), _mm_set1_epi16(0xFF));
+        };
+        return {channel(rt), channel(gt), channel(bt)};
+    }
+
+    void toRGB15SIMD(const int16_t* blocks, uint16_t* out, bool is_signed, bool set_bit15) {
+        alignas(16) int16_t rt[BLOCK_COEFFS], gt[BLOCK_COEFFS], bt[BLOCK_COEFFS];
+        chromaTermsSIMD(blocks, blocks + BLOCK_COEFFS, rt, gt, bt);
+
+        const __m128i flip = _mm_set1_epi16(is_signed ? 0 : 0x80);
+        const __m128i bit15 = _mm_set1_epi16(static_cast<int16_t>(set_bit15 ? 0x8000 : 0));
+        for (int y = 0; y < MB_SIZE; y++) {
+            for (int x = 0; x < MB_SIZE; x += N) {
+                const Row row = rowSSE2(blocks, rt, gt, bt, y, x, flip);
+                __m128i px = _mm_srli_epi16(row.r, 3);
+                px = _mm_or_si128(px, _mm_slli_epi16(_mm_srli_epi16(row.g, 3), 5));
+                px = _mm_or_si128(px, _mm_slli_epi16(_mm_srli_epi16(row.b, 3), 10));
+                store128(out + y * MB_SIZE + x, _mm_or_si128(px, bit15));
+            }
+        }
+    }
+
+    void toRGB24SIMD(const int16_t* blocks, uint8_t* out, bool is_signed) {
+        alignas(16) int16_t rt[BLOCK_COEFFS], gt[BLOCK_COEFFS], bt[BLOCK_COEFFS];
+        chromaTermsSIMD(blocks, blocks + BLOCK_COEFFS, rt, gt, bt);
+
+        const __m128i flip = _mm_set1_epi16(is_signed ? 0 : 0x80);
+        alignas(16) uint32_t px[N];
+        for (int y = 0; y < MB_SIZE; y++) {
+            for (int x = 0; x < MB_SIZE; x += N) {
+                const Row row = rowSSE2(blocks, rt, gt, bt, y, x, flip);
+
+                // 0x00BBGGRR per pixel
+                const __m128i rg = _mm_or_si128(row.r, _mm_slli_epi16(row.g, 8));
+                _mm_store_si128(reinterpret_cast<__m128i*>(px), _mm_unpacklo_epi16(rg, row.b));
+                _mm_store_si128(reinterpret_cast<__m128i*>(px + 4), _mm_unpackhi_epi16(rg, row.b));
+
+                uint8_t* dst = out + (y * MB_SIZE + x) * 3;
+                for (int i = 0; i < N; i++) {
+                    std::memcpy(dst + i * 3, &px[i], 3);
+                }
+            }
+        }
+    }
+
+#endif
+
+}
+
+void IDCTTable::set(const int16_t* matrix) {
+    for (int u = 0; u < N; u++) {
+        for (int x = 0; x < N; x++) {
+            rows[u * N + x] = matrix[u * N + x];
+            transposed[x * N + u] = matrix[u * N + x];
+        }
+    }
+}
+
+void idct(const int16_t* coeffs, const IDCTTable& table, int16_t* out) {
+#if defined(MB_AVX2) || defined(MB_SSE2)
+    idctSIMD(coeffs, table, out);
+#ifdef DEBUG
+    // Check the vector kernel against the reference on every call in debug builds
+    int16_t ref[BLOCK_COEFFS];
+    idctScalar(coeffs, table, ref);
+    assert(std::equal(ref, ref + BLOCK_COEFFS, out));
+#endif
+#else
+    idctScalar(coeffs, table, out);
+#endif
+}
+
+void toRGB15(const int16_t* blocks, uint16_t* out, bool is_signed, bool set_bit15) {
+#if defined(MB_AVX2) || defined(MB_SSE2)
+    toRGB15SIMD(blocks, out, is_signed, set_bit15);
+#ifdef DEBUG
+    uint16_t ref[MB_SIZE * MB_SIZE];
+    toRGB15Scalar(blocks, ref, is_signed, set_bit15);
+    assert(std::memcmp(ref, out, sizeof(ref)) == 0);
+#endif
+#else
+    toRGB15Scalar(blocks, out, is_signed, set_bit15);
+#endif
+}
+
+void toRGB24(const int16_t* blocks, uint8_t* out, bool is_signed) {
+#if defined(MB_AVX2) || defined(MB_SSE2)
+    toRGB24SIMD(blocks, out, is_signed);
+#ifdef DEBUG
+    uint8_t ref[MB_SIZE * MB_SIZE * 3];
+    toRGB24Scalar(blocks, ref, is_signed);
+    assert(std::memcmp(ref, out, sizeof(ref)) == 0);
+#endif
+#else
+    toRGB24Scalar(blocks, out, is_signed);
+#endif
+}
+
+const char* backend() {
+#if defined(MB_AVX2)
+    return "avx2";
+#elif defined(MB_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+}
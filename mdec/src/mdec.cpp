@@ -0,0 +1,455 @@
+/*
+    Description: MDEC (Macroblock Decoder) Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "mdec.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // Commands (bits 29-31 of the command word)
+    constexpr uint32_t CMD_DECODE = 1;
+    constexpr uint32_t CMD_SET_QUANT = 2;
+    constexpr uint32_t CMD_SET_IDCT = 3;
+
+    // Control register
+    constexpr uint32_t CTRL_RESET = 1u << 31;
+    constexpr uint32_t CTRL_DMA_IN = 1u << 30;
+    constexpr uint32_t CTRL_DMA_OUT = 1u << 29;
+
+    // Fills the gap between blocks; a block header is never FE00h
+    constexpr uint16_t PADDING = 0xFE00;
+
+    // Coefficient order of the RLE stream
+    constexpr uint8_t ZIGZAG[64] = {
+         0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+        12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+        35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+        58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+    };
+
+    inline int32_t signed10(uint16_t n) {
+        return static_cast<int16_t>(n << 6) >> 6;
+    }
+
+    // Walk one block without decoding it. Fails if the stream ends first.
+    bool skipBlock(const uint16_t*& src, const uint16_t* end) {
+        uint16_t n;
+        do {
+            if (src == end) return false;
+            n = *src++;
+        } while (n == PADDING);
+
+        for (int k = 0; ; ) {
+            if (src == end) return false;
+            n = *src++;
+            k += (n >> 10) + 1;
+            if (k > 63) return true;
+        }
+    }
+}
+
+MDEC::MDEC(Bus* bus) : bus(bus) {
+    init();
+}
+
+MDEC::~MDEC() {
+    stopWorkers();
+}
+
+void MDEC::init() {
+    luma_quant.fill(0);
+    chroma_quant.fill(0);
+
+    const int16_t zero[Macroblock::BLOCK_COEFFS] = {};
+    idct_table.set(zero);
+
+    dma_in_enabled = false;
+    dma_out_enabled = false;
+    reset();
+}
+
+void MDEC::reset() {
+    command = 0;
+    params_remaining = 0;
+    params.clear();
+
+    depth = Depth::Mono4;
+    is_signed = false;
+    set_bit15 = false;
+
+    macroblocks.clear();
+    output_pos = 0;
+    spill_index = UINT32_MAX;
+}
+
+void MDEC::setDecodeThreads(unsigned count) {
+    stopWorkers();
+    for (unsigned i = 1; i < count; i++) {
+        workers.emplace_back(&MDEC::workerLoop, this, generation);
+    }
+}
+
+DMAPort MDEC::dmaInPort() {
+    DMAPort port;
+    port.ctx = this;
+    port.toDevice = &MDEC::dmaToDevice;
+    return port;
+}
+
+DMAPort MDEC::dmaOutPort() {
+    DMAPort port;
+    port.ctx = this;
+    port.fromDevice = &MDEC::dmaFromDevice;
+    return port;
+}
+
+void MDEC::dmaToDevice(void* ctx, const uint32_t* words, uint32_t count) {
+    MDEC* mdec = static_cast<MDEC*>(ctx);
+    while (count > 0) {
+        // A transfer may carry the command word in front of its parameters
+        if (mdec->params_remaining == 0) {
+            mdec->writeCommand(*words++);
+            count--;
+            continue;
+        }
+
+        const uint32_t run = std::min(count, mdec->params_remaining);
+        mdec->receive(words, run);
+        words += run;
+        count -= run;
+    }
+}
+
+void MDEC::dmaFromDevice(void* ctx, uint32_t* words, uint32_t count) {
+    static_cast<MDEC*>(ctx)->readOutput(reinterpret_cast<uint8_t*>(words), count * 4);
+}
+
+uint32_t MDEC::read32(uint32_t offset) {
+    if (offset & 4) {
+        return status();
+    }
+
+    uint32_t value;
+    readOutput(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+    return value;
+}
+
+void MDEC::write32(uint32_t offset, uint32_t data) {
+    if (!(offset & 4)) {
+        writeCommand(data);
+        return;
+    }
+
+    if (data & CTRL_RESET) {
+        reset();
+    }
+    dma_in_enabled = (data & CTRL_DMA_IN) != 0;
+    dma_out_enabled = (data & CTRL_DMA_OUT) != 0;
+}
+
+uint32_t MDEC::status() const {
+    const bool output_empty = output_pos >= outputBytes();
+
+    uint32_t stat = 0;
+    if (output_empty) stat |= 1u << 31;
+    if (params_remaining > 0 || !output_empty) stat |= 1u << 29;    // Command busy
+    if (dma_in_enabled && params_remaining > 0) stat |= 1u << 28;
+    if (dma_out_enabled && !output_empty) stat |= 1u << 27;
+    stat |= ((command >> 25) & 0xF) << 23;                          // Depth, signed, bit 15
+    stat |= 4u << 16;                                               // Current block
+    stat |= (params_remaining - 1) & 0xFFFF;                        // FFFFh when idle
+    return stat;
+}
+
+void MDEC::writeCommand(uint32_t word) {
+    if (params_remaining > 0) {
+        receive(&word, 1);
+        return;
+    }
+
+    command = word;
+    params.clear();
+
+    switch (word >> 29) {
+        case CMD_DECODE:
+            depth = static_cast<Depth>((word >> 27) & 3);
+            is_signed = (word >> 26) & 1;
+            set_bit15 = (word >> 25) & 1;
+            macroblocks.clear();
+            output_pos = 0;
+            spill_index = UINT32_MAX;
+            params_remaining = word & 0xFFFF;
+            break;
+        case CMD_SET_QUANT:
+            // Luminance table, plus the colour table when bit 0 is set
+            params_remaining = (word & 1) ? 32 : 16;
+            break;
+        case CMD_SET_IDCT:
+            params_remaining = 32;
+            break;
+        default:
+            params_remaining = 0;
+            break;
+    }
+
+    params.reserve(params_remaining);
+    if (params_remaining == 0) {
+        execute();
+    }
+}
+
+void MDEC::receive(const uint32_t* words, uint32_t count) {
+    count = std::min(count, params_remaining);
+    params.insert(params.end(), words, words + count);
+    params_remaining -= count;
+
+    if (params_remaining == 0) {
+        execute();
+    }
+}
+
+void MDEC::execute() {
+    switch (command >> 29) {
+        case CMD_DECODE:
+            scanMacroblocks();
+            break;
+        case CMD_SET_QUANT:
+            std::memcpy(luma_quant.data(), params.data(), luma_quant.size());
+            if (command & 1) {
+                std::memcpy(chroma_quant.data(), reinterpret_cast<const uint8_t*>(params.data()) + 64, chroma_quant.size());
+            }
+            break;
+        case CMD_SET_IDCT: {
+            int16_t matrix[Macroblock::BLOCK_COEFFS];
+            std::memcpy(matrix, params.data(), sizeof(matrix));
+            idct_table.set(matrix);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// --- Output ---
+
+uint32_t MDEC::macroblockBytes() const {
+    switch (depth) {
+        case Depth::Mono4: return 8 * 8 / 2;
+        case Depth::Mono8: return 8 * 8;
+        case Depth::RGB24: return 16 * 16 * 3;
+        case Depth::RGB15: return 16 * 16 * 2;
+    }
+    return 0;
+}
+
+void MDEC::readOutput(uint8_t* dst, uint32_t bytes) {
+    const uint32_t mb_bytes = macroblockBytes();
+
+    // Finish the macroblock an earlier read stopped inside of
+    const uint32_t partial = output_pos % mb_bytes;
+    if (partial != 0) {
+        const uint32_t run = std::min(bytes, mb_bytes - partial);
+        readSpill(dst, run);
+        dst += run;
+        bytes -= run;
+    }
+
+    // Whole macroblocks are decoded straight into the destination
+    const uint32_t first = output_pos / mb_bytes;
+    if (first < macroblocks.size()) {
+        const uint32_t whole = std::min<uint32_t>(bytes / mb_bytes, static_cast<uint32_t>(macroblocks.size()) - first);
+        if (whole > 0) {
+            decodeRange(first, whole, dst);
+            dst += whole * mb_bytes;
+            bytes -= whole * mb_bytes;
+            output_pos += whole * mb_bytes;
+        }
+    }
+
+    if (bytes > 0) {
+        readSpill(dst, bytes);
+    }
+}
+
+void MDEC::readSpill(uint8_t* dst, uint32_t bytes) {
+    const uint32_t mb_bytes = macroblockBytes();
+
+    while (bytes > 0) {
+        const uint32_t index = output_pos / mb_bytes;
+        if (index >= macroblocks.size()) {
+            // Reading past the decoded data returns zeroes
+            std::memset(dst, 0, bytes);
+            return;
+        }
+
+        if (spill_index != index) {
+            decodeMacroblock(index, spill.data());
+            spill_index = index;
+        }
+
+        const uint32_t offset = output_pos % mb_bytes;
+        const uint32_t run = std::min(bytes, mb_bytes - offset);
+        std::memcpy(dst, spill.data() + offset, run);
+        dst += run;
+        bytes -= run;
+        output_pos += run;
+    }
+}
+
+// --- Decoding ---
+
+void MDEC::scanMacroblocks() {
+    macroblocks.clear();
+
+    const uint16_t* stream = reinterpret_cast<const uint16_t*>(params.data());
+    const uint16_t* end = stream + params.size() * 2;
+    const int blocks = (depth == Depth::RGB24 || depth == Depth::RGB15) ? Macroblock::COLOUR_BLOCKS : 1;
+
+    // A truncated trailing macroblock produces no output
+    const uint16_t* src = stream;
+    for (;;) {
+        const uint32_t start = static_cast<uint32_t>(src - stream);
+        int b = 0;
+        while (b < blocks && skipBlock(src, end)) {
+            b++;
+        }
+        if (b < blocks) break;
+        macroblocks.push_back(start);
+    }
+}
+
+void MDEC::decodeRange(uint32_t first, uint32_t count, uint8_t* dst) {
+    const uint32_t mb_bytes = macroblockBytes();
+
+    if (workers.empty() || count == 1) {
+        for (uint32_t i = 0; i < count; i++) {
+            decodeMacroblock(first + i, dst + i * mb_bytes);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        job_first = first;
+        job_count = count;
+        job_dst = dst;
+        next_job.store(0, std::memory_order_relaxed);
+        generation++;
+        busy_workers = static_cast<unsigned>(workers.size());
+    }
+    start_cv.notify_all();
+
+    // The requesting thread decodes macroblocks too
+    runJobs();
+
+    std::unique_lock<std::mutex> lock(pool_mutex);
+    done_cv.wait(lock, [this] { return busy_workers == 0; });
+}
+
+void MDEC::decodeMacroblock(uint32_t index, uint8_t* dst) const {
+    const uint16_t* src = reinterpret_cast<const uint16_t*>(params.data()) + macroblocks[index];
+
+    alignas(32) int16_t coeffs[Macroblock::BLOCK_COEFFS];
+    alignas(32) int16_t blocks[Macroblock::COLOUR_BLOCKS * Macroblock::BLOCK_COEFFS];
+
+    if (depth == Depth::RGB24 || depth == Depth::RGB15) {
+        for (int b = 0; b < Macroblock::COLOUR_BLOCKS; b++) {
+            decodeBlock(src, b < 2 ? chroma_quant.data() : luma_quant.data(), coeffs);
+            Macroblock::idct(coeffs, idct_table, blocks + b * Macroblock::BLOCK_COEFFS);
+        }
+
+        if (depth == Depth::RGB15) {
+            Macroblock::toRGB15(blocks, reinterpret_cast<uint16_t*>(dst), is_signed, set_bit15);
+        } else {
+            Macroblock::toRGB24(blocks, dst, is_signed);
+        }
+        return;
+    }
+
+    // Monochrome: a single Y block
+    decodeBlock(src, luma_quant.data(), coeffs);
+    Macroblock::idct(coeffs, idct_table, blocks);
+
+    const int16_t flip = is_signed ? 0 : 0x80;
+    auto pixel = [&](int i) { return static_cast<uint8_t>(blocks[i] ^ flip); };
+
+    if (depth == Depth::Mono8) {
+        for (int i = 0; i < Macroblock::BLOCK_COEFFS; i++) {
+            dst[i] = pixel(i);
+        }
+    } else {
+        for (int i = 0; i < Macroblock::BLOCK_COEFFS / 2; i++) {
+            dst[i] = static_cast<uint8_t>((pixel(i * 2) >> 4) | (pixel(i * 2 + 1) & 0xF0));
+        }
+    }
+}
+
+void MDEC::decodeBlock(const uint16_t*& src, const uint8_t* quant, int16_t* out) const {
+    std::fill_n(out, Macroblock::BLOCK_COEFFS, 0);
+
+    // scanMacroblocks() guarantees the block is complete
+    uint16_t n = *src++;
+    while (n == PADDING) {
+        n = *src++;
+    }
+
+    // DC: the top 6 bits carry the quantiser scale of the whole block
+    const int32_t q_scale = n >> 10;
+    int32_t val = signed10(n) * quant[0];
+
+    for (int k = 0; ; ) {
+        if (q_scale == 0) val = signed10(n) * 2;
+        val = std::clamp<int32_t>(val, -0x400, 0x3FF);
+        out[q_scale > 0 ? ZIGZAG[k] : k] = static_cast<int16_t>(val);
+
+        n = *src++;
+        k += (n >> 10) + 1;
+        if (k > 63) break;
+        val = (signed10(n) * quant[k] * q_scale + 4) / 8;
+    }
+}
+
+// --- Worker pool ---
+
+void MDEC::runJobs() {
+    const uint32_t mb_bytes = macroblockBytes();
+    for (;;) {
+        const uint32_t i = next_job.fetch_add(1, std::memory_order_relaxed);
+        if (i >= job_count) break;
+        decodeMacroblock(job_first + i, job_dst + i * mb_bytes);
+    }
+}
+
+void MDEC::workerLoop(uint64_t seen) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            start_cv.wait(lock, [&] { return quit || generation != seen; });
+            if (quit) return;
+            seen = generation;
+        }
+
+        runJobs();
+
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (--busy_workers == 0) {
+            done_cv.notify_one();
+        }
+    }
+}
+
+void MDEC::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        quit = true;
+    }
+    start_cv.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    quit = false;
+}
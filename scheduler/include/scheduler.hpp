@@ -0,0 +1,77 @@
+/*
+    Description: Cycle Scheduler Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// Every timed event in the machine owns exactly one slot. Keeping the set fixed
+// lets the scheduler stay a flat array with a cached "next deadline", so the
+// per-instruction cost is a single compare.
+enum class Event : uint8_t {
+    DMA0, DMA1, DMA2, DMA3, DMA4, DMA5, DMA6,
+    Timer0, Timer1, Timer2,
+    VBlank,
+    SPU,
+    CDROM, CDROMSector,
+    SIO0,
+    Count
+};
+
+using EventHandler = void (*)(void* ctx, uint64_t now);
+
+class Scheduler {
+    public:
+        Scheduler();
+        ~Scheduler();
+
+        void init();
+
+        // Bind a handler to a slot. Done once at device init; scheduling only arms the slot.
+        void registerEvent(Event event, EventHandler handler, void* ctx);
+
+        // Arm (or re-arm) an event to fire `delay` cycles from now.
+        void schedule(Event event, uint64_t delay);
+        void scheduleAt(Event event, uint64_t timestamp);
+        void cancel(Event event);
+
+        bool isScheduled(Event event) const { return slots[index(event)].active; }
+        uint64_t deadline(Event event) const { return slots[index(event)].deadline; }
+
+        // Master cycle timestamp (CPU clock, 33.8688 MHz)
+        uint64_t timestamp() const { return now; }
+
+        inline void advance(uint32_t cycles) {
+            now += cycles;
+            if (now >= next_deadline) {
+                dispatch();
+            }
+        }
+
+    private:
+        struct Slot {
+            uint64_t deadline;
+            EventHandler handler;
+            void* ctx;
+            bool active;
+        };
+
+        static constexpr size_t EVENT_COUNT = static_cast<size_t>(Event::Count);
+        static constexpr uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+
+        static constexpr size_t index(Event event) { return static_cast<size_t>(event); }
+
+        void dispatch();
+        void recompute();
+
+        std::array<Slot, EVENT_COUNT> slots;
+
+        uint64_t now = 0;
+        uint64_t next_deadline = NEVER;
+};
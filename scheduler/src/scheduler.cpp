@@ -0,0 +1,77 @@
+/*
+    Description: Cycle Scheduler Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "scheduler.hpp"
+
+Scheduler::Scheduler() {
+    init();
+}
+
+Scheduler::~Scheduler() = default;
+
+void Scheduler::init() {
+    for (auto& slot : slots) {
+        slot = {NEVER, nullptr, nullptr, false};
+    }
+    now = 0;
+    next_deadline = NEVER;
+}
+
+void Scheduler::registerEvent(Event event, EventHandler handler, void* ctx) {
+    Slot& slot = slots[index(event)];
+    slot.handler = handler;
+    slot.ctx = ctx;
+}
+
+void Scheduler::schedule(Event event, uint64_t delay) {
+    scheduleAt(event, now + delay);
+}
+
+void Scheduler::scheduleAt(Event event, uint64_t timestamp) {
+    Slot& slot = slots[index(event)];
+    slot.deadline = timestamp;
+    slot.active = true;
+
+    if (timestamp < next_deadline) {
+        next_deadline = timestamp;
+    }
+}
+
+void Scheduler::cancel(Event event) {
+    Slot& slot = slots[index(event)];
+    if (!slot.active) return;
+
+    slot.active = false;
+    slot.deadline = NEVER;
+    recompute();
+}
+
+void Scheduler::dispatch() {
+    // Handlers may re-arm themselves (or other slots), so keep going until
+    // nothing is due at the current timestamp.
+    while (next_deadline <= now) {
+        for (auto& slot : slots) {
+            if (slot.active && slot.deadline <= now) {
+                slot.active = false;
+                uint64_t fired_at = slot.deadline;
+                slot.deadline = NEVER;
+                if (slot.handler) {
+                    slot.handler(slot.ctx, fired_at);
+                }
+            }
+        }
+        recompute();
+    }
+}
+
+void Scheduler::recompute() {
+    next_deadline = NEVER;
+    for (const auto& slot : slots) {
+        if (slot.active && slot.deadline < next_deadline) {
+            next_deadline = slot.deadline;
+        }
+    }
+}
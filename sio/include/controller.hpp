@@ -0,0 +1,43 @@
+/*
+    Description: Digital Controller Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "sio.hpp"
+
+// Bit positions in the pad's button halfword (sent active-low)
+enum PadButton : uint16_t {
+    PAD_SELECT   = 1 << 0,
+    PAD_START    = 1 << 3,
+    PAD_UP       = 1 << 4,
+    PAD_RIGHT    = 1 << 5,
+    PAD_DOWN     = 1 << 6,
+    PAD_LEFT     = 1 << 7,
+    PAD_L2       = 1 << 8,
+    PAD_R2       = 1 << 9,
+    PAD_L1       = 1 << 10,
+    PAD_R1       = 1 << 11,
+    PAD_TRIANGLE = 1 << 12,
+    PAD_CIRCLE   = 1 << 13,
+    PAD_CROSS    = 1 << 14,
+    PAD_SQUARE   = 1 << 15
+};
+
+// SCPH-1080 digital pad: answers the 0x42 poll with ID 0x5A41 and two button bytes
+class DigitalPad : public SerialDevice {
+    public:
+        // PadButton bits of the buttons held down
+        void setButtons(uint16_t pressed) { buttons = pressed; }
+
+        uint8_t exchange(uint8_t in, bool& ack) override;
+        void deselect() override { step = 0; }
+
+    private:
+        uint16_t buttons = 0;
+        uint32_t step = 0;
+};
@@ -0,0 +1,82 @@
+/*
+    Description: Memory Card Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "sio.hpp"
+
+// 128KB memory card backed by a shared mapping of its file. A sector written
+// over the serial protocol is copied into the mapping and marked dirty; a
+// flusher thread msyncs the dirty sectors once writes have been quiet for a
+// debounce interval, so a game saving (hundreds of sector writes in a row) never
+// waits on the disk from the emulation thread. Close flushes what is left.
+class MemoryCard : public SerialDevice {
+    public:
+        static constexpr uint32_t SECTOR_SIZE = 128;
+        static constexpr uint32_t SECTORS = 1024;
+        static constexpr uint32_t SIZE = SECTOR_SIZE * SECTORS;
+
+        MemoryCard();
+        ~MemoryCard();
+
+        MemoryCard(const MemoryCard&) = delete;
+        MemoryCard& operator=(const MemoryCard&) = delete;
+
+        // Opens (or creates and formats) the card file; false leaves the slot empty
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const { return data != nullptr; }
+
+        uint8_t exchange(uint8_t in, bool& ack) override;
+        void deselect() override { state = State::Idle; }
+
+    private:
+        static constexpr uint32_t DIRTY_WORDS = SECTORS / 64;
+
+        // FLAG bit 3: no write since power-on (cleared by the first good write)
+        static constexpr uint8_t FLAG_FRESH = 0x08;
+
+        enum class State : uint8_t { Idle, Command, Read, Write, GetID };
+
+        void format();
+        void commitSector();
+        void markDirty(uint32_t sector);
+
+        // --- Flusher thread ---
+        void flushLoop();
+        void flushDirty();
+
+        uint8_t* data = nullptr;
+        int fd = -1;
+
+        // Protocol
+        State state = State::Idle;
+        uint32_t step = 0;
+        uint8_t flag = FLAG_FRESH;
+        uint16_t sector = 0;
+        uint8_t last_in = 0;
+        uint8_t checksum = 0;
+        bool checksum_ok = false;
+        std::array<uint8_t, SECTOR_SIZE> buffer = {};
+
+        // Write-back
+        std::array<std::atomic<uint64_t>, DIRTY_WORDS> dirty;
+        std::atomic<int64_t> last_write{0};     // steady_clock ticks
+
+        std::thread flusher;
+        std::mutex flush_mutex;
+        std::condition_variable flush_wake;
+        bool quit = false;
+};
@@ -0,0 +1,100 @@
+/*
+    Description: Serial Port 0 (Controllers / Memory Cards) Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+class Bus;
+
+// A device on one of the two controller ports. The pad and the memory card of a
+// port share the wires: the first byte of a command addresses one of them
+// (0x01 pad, 0x81 card) and only that one answers until the port is deselected.
+class SerialDevice {
+    public:
+        virtual ~SerialDevice() = default;
+
+        // Exchange one byte. Setting `ack` pulls /ACK, telling the host the
+        // device expects another byte; the last byte of a command leaves it clear.
+        virtual uint8_t exchange(uint8_t in, bool& ack) = 0;
+
+        // /JOYn went high: the next byte starts a new command
+        virtual void deselect() = 0;
+};
+
+// SIO0 at 0x1F801040. A byte written to JOY_DATA is shifted out at the baud rate
+// by a scheduler event; the device's answer lands in the RX FIFO when it ends
+// and, if the device acknowledged, a second event raises /ACK (and IRQ7) a
+// little later, the way pads and cards answer on hardware.
+class SIO {
+    public:
+        SIO(Bus* bus);
+        ~SIO();
+
+        void init();
+
+        // Register interface (offset relative to 0x1F801040, halfword registers)
+        uint16_t read16(uint32_t offset);
+        void write16(uint32_t offset, uint16_t value);
+
+        // Either may be nullptr (nothing plugged in)
+        void connectPad(int port, SerialDevice* pad) { ports[port].pad = pad; }
+        void connectCard(int port, SerialDevice* card) { ports[port].card = card; }
+
+    private:
+        static constexpr uint32_t RX_FIFO_SIZE = 8;
+
+        // JOY_STAT
+        static constexpr uint32_t STAT_TX_READY = 1 << 0;
+        static constexpr uint32_t STAT_RX_READY = 1 << 1;
+        static constexpr uint32_t STAT_TX_DONE = 1 << 2;
+        static constexpr uint32_t STAT_ACK_LEVEL = 1 << 7;
+        static constexpr uint32_t STAT_IRQ = 1 << 9;
+
+        // JOY_CTRL
+        static constexpr uint16_t CTRL_TX_ENABLE = 1 << 0;
+        static constexpr uint16_t CTRL_SELECT = 1 << 1;
+        static constexpr uint16_t CTRL_ACKNOWLEDGE = 1 << 4;
+        static constexpr uint16_t CTRL_RESET = 1 << 6;
+        static constexpr uint16_t CTRL_ACK_IRQ = 1 << 12;
+        static constexpr uint16_t CTRL_PORT2 = 1 << 13;
+
+        enum class Phase : uint8_t { Idle, Shifting, Acking };
+
+        struct Port {
+            SerialDevice* pad = nullptr;
+            SerialDevice* card = nullptr;
+            SerialDevice* active = nullptr;     // Addressed by the first byte
+            bool addressed = false;
+        };
+
+        static void onEvent(void* ctx, uint64_t now);
+
+        void startTransfer();
+        void finishTransfer();
+        void raiseAck();
+        void deselect();
+        uint32_t byteCycles() const;
+
+        Bus* bus;
+        std::array<Port, 2> ports;
+
+        uint16_t mode = 0;
+        uint16_t ctrl = 0;
+        uint16_t baud = 0;
+
+        Phase phase = Phase::Idle;
+        uint8_t tx_data = 0;
+        bool tx_pending = false;
+        uint8_t shifting = 0;
+        bool ack_level = false;
+        bool irq = false;
+
+        std::array<uint8_t, RX_FIFO_SIZE> rx_fifo = {};
+        uint32_t rx_read = 0;
+        uint32_t rx_count = 0;
+};
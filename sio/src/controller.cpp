@@ -0,0 +1,20 @@
+/*
+    Description: Digital Controller Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "controller.hpp"
+
+uint8_t DigitalPad::exchange(uint8_t in, bool& ack) {
+    const uint16_t state = static_cast<uint16_t>(~buttons);
+
+    switch (step++) {
+        case 0: ack = true; return 0xFF;                    // Address (0x01)
+        case 1: ack = in == 0x42; return 0x41;              // Read command, ID low
+        case 2: ack = true; return 0x5A;                    // ID high
+        case 3: ack = true; return state & 0xFF;
+        case 4: ack = false; return state >> 8;             // Last byte: no /ACK
+        default: ack = false; return 0xFF;
+    }
+}
@@ -0,0 +1,292 @@
+/*
+    Description: Memory Card Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "memory_card.hpp"
+#include "log.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Flush once the card has seen no writes for this long
+    constexpr auto DEBOUNCE = std::chrono::milliseconds(500);
+    constexpr auto FLUSH_POLL = std::chrono::milliseconds(100);
+
+    // Step (byte after the command byte) at which the 128 data bytes start
+    constexpr uint32_t READ_DATA = 8;
+    constexpr uint32_t WRITE_DATA = 4;
+
+    int64_t ticks() {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    uint8_t frameChecksum(const uint8_t* frame) {
+        uint8_t sum = 0;
+        for (uint32_t i = 0; i < MemoryCard::SECTOR_SIZE - 1; i++) sum ^= frame[i];
+        return sum;
+    }
+}
+
+MemoryCard::MemoryCard() {
+    for (auto& word : dirty) word.store(0, std::memory_order_relaxed);
+}
+
+MemoryCard::~MemoryCard() {
+    close();
+}
+
+bool MemoryCard::open(const std::string& path) {
+    close();
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        std::cerr << "[MemCard] Failed to open " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    const bool fresh = fstat(fd, &st) == 0 && st.st_size == 0;
+    if (fresh && ftruncate(fd, SIZE) != 0) {
+        std::cerr << "[MemCard] Failed to create " << path << ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    if (!fresh && st.st_size != SIZE) {
+        std::cerr << "[MemCard] " << path << " is not a 128KB memory card image" << std::endl;
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+
+    // Populated up front so stores from the emulation thread never fault to disk
+    void* mapping = mmap(nullptr, SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "[MemCard] Failed to map " << path << ": " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    data = static_cast<uint8_t*>(mapping);
+
+    if (fresh) {
+        format();
+        msync(data, SIZE, MS_SYNC);
+    }
+
+    state = State::Idle;
+    flag = FLAG_FRESH;
+    quit = false;
+    flusher = std::thread(&MemoryCard::flushLoop, this);
+    return true;
+}
+
+void MemoryCard::close() {
+    if (!data) return;
+
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        quit = true;
+    }
+    flush_wake.notify_one();
+    flusher.join();
+    flushDirty();
+
+    munmap(data, SIZE);
+    ::close(fd);
+    data = nullptr;
+    fd = -1;
+}
+
+// Empty card as the BIOS formats it: header, 15 free directory frames, an empty
+// broken-sector list and the write-test frame
+void MemoryCard::format() {
+    std::memset(data, 0, SIZE);
+
+    auto frame = [&](uint32_t index) { return data + index * SECTOR_SIZE; };
+
+    frame(0)[0] = 'M';
+    frame(0)[1] = 'C';
+    for (uint32_t i = 1; i < 16; i++) {
+        frame(i)[0] = 0xA0;
+        frame(i)[8] = frame(i)[9] = 0xFF;
+    }
+    for (uint32_t i = 16; i < 36; i++) {
+        std::memset(frame(i), 0xFF, 4);
+        frame(i)[8] = frame(i)[9] = 0xFF;
+    }
+    for (uint32_t i = 0; i < 36; i++) {
+        frame(i)[SECTOR_SIZE - 1] = frameChecksum(frame(i));
+    }
+    std::memcpy(frame(63), frame(0), SECTOR_SIZE);
+}
+
+uint8_t MemoryCard::exchange(uint8_t in, bool& ack) {
+    ack = true;
+    uint8_t out = 0xFF;
+
+    switch (state) {
+        case State::Idle:
+            // No card in the slot: nothing answers
+            if (!data || in != 0x81) {
+                ack = false;
+                break;
+            }
+            state = State::Command;
+            break;
+
+        case State::Command:
+            step = 0;
+            if (in == 'R') state = State::Read;
+            else if (in == 'W') state = State::Write;
+            else if (in == 'S') state = State::GetID;
+            else {
+                state = State::Idle;
+                ack = false;
+                break;
+            }
+            out = flag;
+            break;
+
+        case State::Read: {
+            const uint32_t s = step++;
+            if (s == 0) out = 0x5A;
+            else if (s == 1) out = 0x5D;
+            else if (s == 2) { sector = static_cast<uint16_t>(in << 8); out = 0x00; }
+            else if (s == 3) { sector |= in; out = last_in; }
+            else if (s == 4) out = 0x5C;
+            else if (s == 5) out = 0x5D;
+            else if (s == 6) {
+                if (sector >= SECTORS) {
+                    // Bad sector: the confirmed address reads FFFFh and the command ends
+                    state = State::Idle;
+                    ack = false;
+                    break;
+                }
+                checksum = static_cast<uint8_t>((sector >> 8) ^ (sector & 0xFF));
+                out = static_cast<uint8_t>(sector >> 8);
+            }
+            else if (s == 7) out = static_cast<uint8_t>(sector & 0xFF);
+            else if (s < READ_DATA + SECTOR_SIZE) {
+                out = data[sector * SECTOR_SIZE + (s - READ_DATA)];
+                checksum ^= out;
+            }
+            else if (s == READ_DATA + SECTOR_SIZE) out = checksum;
+            else {
+                out = 0x47;     // 'G'
+                state = State::Idle;
+                ack = false;
+            }
+            break;
+        }
+
+        case State::Write: {
+            const uint32_t s = step++;
+            if (s == 0) out = 0x5A;
+            else if (s == 1) out = 0x5D;
+            else if (s == 2) { sector = static_cast<uint16_t>(in << 8); out = 0x00; }
+            else if (s == 3) {
+                sector |= in;
+                checksum = static_cast<uint8_t>((sector >> 8) ^ (sector & 0xFF));
+                out = last_in;
+            }
+            else if (s < WRITE_DATA + SECTOR_SIZE) {
+                buffer[s - WRITE_DATA] = in;
+                checksum ^= in;
+                out = last_in;
+            }
+            else if (s == WRITE_DATA + SECTOR_SIZE) {
+                checksum_ok = in == checksum;
+                out = last_in;
+            }
+            else if (s == WRITE_DATA + SECTOR_SIZE + 1) out = 0x5C;
+            else if (s == WRITE_DATA + SECTOR_SIZE + 2) out = 0x5D;
+            else {
+                if (sector >= SECTORS) out = 0xFF;
+                else if (!checksum_ok) out = 0x4E;  // 'N'
+                else {
+                    commitSector();
+                    flag &= ~FLAG_FRESH;
+                    out = 0x47;
+                }
+                state = State::Idle;
+                ack = false;
+            }
+            break;
+        }
+
+        case State::GetID: {
+            static const uint8_t reply[] = {0x5A, 0x5D, 0x5C, 0x5D, 0x04, 0x00, 0x00, 0x80};
+            out = reply[step++];
+            if (step == sizeof(reply)) {
+                state = State::Idle;
+                ack = false;
+            }
+            break;
+        }
+    }
+
+    last_in = in;
+    return out;
+}
+
+void MemoryCard::commitSector() {
+    std::memcpy(data + sector * SECTOR_SIZE, buffer.data(), SECTOR_SIZE);
+    markDirty(sector);
+}
+
+void MemoryCard::markDirty(uint32_t index) {
+    dirty[index / 64].fetch_or(uint64_t(1) << (index % 64), std::memory_order_relaxed);
+    last_write.store(ticks(), std::memory_order_release);
+}
+
+// --- Flusher thread ---
+
+void MemoryCard::flushLoop() {
+    std::unique_lock<std::mutex> lock(flush_mutex);
+    while (!quit) {
+        flush_wake.wait_for(lock, FLUSH_POLL);
+        if (quit) break;
+
+        const auto quiet = std::chrono::steady_clock::duration(ticks() - last_write.load(std::memory_order_acquire));
+        if (quiet < DEBOUNCE) continue;
+
+        lock.unlock();
+        flushDirty();
+        lock.lock();
+    }
+}
+
+// msync works on whole host pages: sectors sharing one are written together
+void MemoryCard::flushDirty() {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const uint32_t per_page = static_cast<uint32_t>(std::max<size_t>(page / SECTOR_SIZE, 1));
+
+    uint32_t flushed = 0;
+    size_t last_page = SIZE_MAX;
+    for (uint32_t w = 0; w < DIRTY_WORDS; w++) {
+        uint64_t bits = dirty[w].exchange(0, std::memory_order_acq_rel);
+        while (bits) {
+            const uint32_t index = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            flushed++;
+
+            const size_t start = (index / per_page) * per_page * SECTOR_SIZE;
+            if (start == last_page) continue;
+            last_page = start;
+            msync(data + start, std::min<size_t>(page, SIZE - start), MS_SYNC);
+        }
+    }
+
+    if (flushed) LOG_DEBUG("MemCard", "Flushed {} dirty sectors", flushed);
+}
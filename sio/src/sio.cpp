@@ -0,0 +1,178 @@
+/*
+    Description: Serial Port 0 (Controllers / Memory Cards) Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "sio.hpp"
+#include "bus.hpp"
+#include <algorithm>
+
+namespace {
+    // Pads and cards pull /ACK roughly 10 us after the end of a byte
+    constexpr uint32_t ACK_DELAY = 338;
+
+    constexpr uint8_t ADDRESS_PAD = 0x01;
+    constexpr uint8_t ADDRESS_CARD = 0x81;
+}
+
+SIO::SIO(Bus* bus) : bus(bus) {
+    init();
+}
+
+SIO::~SIO() = default;
+
+void SIO::init() {
+    mode = 0;
+    ctrl = 0;
+    baud = 0;
+    phase = Phase::Idle;
+    tx_data = 0;
+    tx_pending = false;
+    ack_level = false;
+    irq = false;
+    rx_read = rx_count = 0;
+    deselect();
+
+    bus->scheduler.registerEvent(Event::SIO0, &SIO::onEvent, this);
+}
+
+uint16_t SIO::read16(uint32_t offset) {
+    switch (offset) {
+        case 0x0: {
+            // JOY_DATA: pop the RX FIFO
+            if (rx_count == 0) return 0xFF;
+            const uint8_t value = rx_fifo[rx_read];
+            rx_read = (rx_read + 1) % RX_FIFO_SIZE;
+            rx_count--;
+            return value;
+        }
+        case 0x4: {
+            uint32_t stat = 0;
+            if (!tx_pending) stat |= STAT_TX_READY;
+            if (rx_count > 0) stat |= STAT_RX_READY;
+            if (!tx_pending && phase != Phase::Shifting) stat |= STAT_TX_DONE;
+            if (ack_level) stat |= STAT_ACK_LEVEL;
+            if (irq) stat |= STAT_IRQ;
+            return static_cast<uint16_t>(stat);
+        }
+        case 0x8: return mode;
+        case 0xA: return ctrl;
+        case 0xE: return baud;
+        default: return 0;
+    }
+}
+
+void SIO::write16(uint32_t offset, uint16_t value) {
+    switch (offset) {
+        case 0x0:
+            tx_data = static_cast<uint8_t>(value);
+            tx_pending = true;
+            if ((ctrl & CTRL_TX_ENABLE) && phase == Phase::Idle) startTransfer();
+            break;
+
+        case 0x8:
+            mode = value;
+            break;
+
+        case 0xA: {
+            if (value & CTRL_RESET) {
+                bus->scheduler.cancel(Event::SIO0);
+                mode = ctrl = baud = 0;
+                phase = Phase::Idle;
+                tx_pending = false;
+                ack_level = false;
+                irq = false;
+                rx_read = rx_count = 0;
+                deselect();
+                return;
+            }
+            if (value & CTRL_ACKNOWLEDGE) irq = false;
+
+            const uint16_t old = ctrl;
+            ctrl = value & ~(CTRL_ACKNOWLEDGE | CTRL_RESET);
+
+            // Raising /JOYn (or switching ports) ends the command on both ports
+            if (!(ctrl & CTRL_SELECT) || ((old ^ ctrl) & CTRL_PORT2)) deselect();
+
+            if ((ctrl & CTRL_TX_ENABLE) && tx_pending && phase == Phase::Idle) startTransfer();
+            break;
+        }
+
+        case 0xE:
+            baud = value;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void SIO::onEvent(void* ctx, uint64_t now) {
+    (void)now;
+    SIO* sio = static_cast<SIO*>(ctx);
+    if (sio->phase == Phase::Shifting) sio->finishTransfer();
+    else if (sio->phase == Phase::Acking) sio->raiseAck();
+}
+
+// Eight bits at the reload value times the mode's multiplier (1, 16 or 64)
+uint32_t SIO::byteCycles() const {
+    static const uint32_t factors[] = {1, 1, 16, 64};
+    return std::max<uint32_t>(baud * factors[mode & 3], 1) * 8;
+}
+
+void SIO::startTransfer() {
+    shifting = tx_data;
+    tx_pending = false;
+    ack_level = false;
+    phase = Phase::Shifting;
+    bus->scheduler.schedule(Event::SIO0, byteCycles());
+}
+
+void SIO::finishTransfer() {
+    uint8_t rx = 0xFF;
+    bool ack = false;
+
+    if (ctrl & CTRL_SELECT) {
+        Port& port = ports[(ctrl & CTRL_PORT2) ? 1 : 0];
+        if (!port.addressed) {
+            port.addressed = true;
+            port.active = shifting == ADDRESS_PAD ? port.pad : shifting == ADDRESS_CARD ? port.card : nullptr;
+        }
+        if (port.active) rx = port.active->exchange(shifting, ack);
+    }
+
+    // When the FIFO is full the newest byte replaces the last one in it
+    const uint32_t slot = (rx_read + std::min(rx_count, RX_FIFO_SIZE - 1)) % RX_FIFO_SIZE;
+    rx_fifo[slot] = rx;
+    rx_count = std::min(rx_count + 1, RX_FIFO_SIZE);
+
+    if (ack) {
+        phase = Phase::Acking;
+        bus->scheduler.schedule(Event::SIO0, ACK_DELAY);
+        return;
+    }
+
+    phase = Phase::Idle;
+    if ((ctrl & CTRL_TX_ENABLE) && tx_pending) startTransfer();
+}
+
+void SIO::raiseAck() {
+    ack_level = true;
+    if (ctrl & CTRL_ACK_IRQ) {
+        irq = true;
+        bus->interrupts.request(IRQ::SIO0);
+    }
+
+    phase = Phase::Idle;
+    if ((ctrl & CTRL_TX_ENABLE) && tx_pending) startTransfer();
+}
+
+void SIO::deselect() {
+    for (Port& port : ports) {
+        if (port.pad) port.pad->deselect();
+        if (port.card) port.card->deselect();
+        port.active = nullptr;
+        port.addressed = false;
+    }
+}
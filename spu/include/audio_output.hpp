@@ -0,0 +1,43 @@
+/*
+    Description: SDL Audio Output Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "audio_ring.hpp"
+#include "spu.hpp"
+
+// Plays SPU output on the default SDL audio device. The mixer pushes frames into
+// a lock-free ring from its own thread and SDL's callback drains it; nothing on
+// either side takes a lock.
+class AudioOutput {
+    public:
+        AudioOutput();
+        ~AudioOutput();
+
+        // Returns false when no audio device is available (headless runs keep the null sink)
+        bool open();
+        void close();
+
+        // Producer endpoint for SPU::connectAudio
+        AudioSink sink();
+
+        // Frames the callback had to pad with silence / frames dropped on a full ring
+        uint64_t getUnderruns() const { return underruns.load(std::memory_order_relaxed); }
+        uint64_t getOverruns() const { return overruns.load(std::memory_order_relaxed); }
+
+    private:
+        static void sinkWrite(void* ctx, const int16_t* frames, uint32_t count);
+        static void callback(void* userdata, uint8_t* stream, int len);
+
+        AudioRing ring;
+        uint32_t device = 0;
+
+        std::atomic<uint64_t> underruns{0};
+        std::atomic<uint64_t> overruns{0};
+};
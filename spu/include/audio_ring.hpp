@@ -0,0 +1,44 @@
+/*
+    Description: Single-Producer / Single-Consumer Audio Frame Ring Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Lock-free ring of interleaved stereo frames between the thread that mixes SPU
+// output (producer) and the audio device callback (consumer). Neither side ever
+// waits: a full ring drops the newest frames and an empty one reads short, so
+// emulation speed and device timing stay decoupled.
+class AudioRing {
+    public:
+        explicit AudioRing(size_t capacity_frames);
+        ~AudioRing();
+
+        // --- Producer side ---
+
+        // Returns the number of frames that fit; the rest are dropped
+        size_t write(const int16_t* frames, size_t count);
+
+        // --- Consumer side ---
+
+        // Returns the number of frames read (short on underrun)
+        size_t read(int16_t* frames, size_t count);
+
+        size_t available() const {
+            return static_cast<size_t>(write_pos.load(std::memory_order_acquire) - read_pos.load(std::memory_order_acquire));
+        }
+
+    private:
+        size_t capacity;
+        size_t mask;
+        std::vector<int16_t> buffer;    // 2 samples per frame
+
+        alignas(64) std::atomic<uint64_t> write_pos{0};
+        alignas(64) std::atomic<uint64_t> read_pos{0};
+};
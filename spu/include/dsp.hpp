@@ -0,0 +1,38 @@
+/*
+    Description: SPU Voice DSP Kernels Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <cstdint>
+
+// Batch kernels behind the SPU mixer. Each one runs over a whole run of output
+// samples for one voice, so the vector width goes across samples; the voice loop
+// in the SPU accumulates every voice into the same mix buffers.
+namespace DSP {
+
+    constexpr int BLOCK_BYTES = 16;
+    constexpr int SAMPLES_PER_BLOCK = 28;
+
+    // Decode one ADPCM block into 28 samples. `old`/`older` carry the filter
+    // history from block to block.
+    void decodeBlock(const uint8_t* block, int16_t* out, int32_t& old, int32_t& older);
+
+    // Gaussian interpolation followed by the ADSR level:
+    //   out[k] = clamp16(gauss(pcm[pos[k]..pos[k] + 3], frac[k])) * env[k] >> 15
+    // pcm[pos[k]] is the oldest of the four taps; frac[k] is counter bits 4-11.
+    void interpolate(const int16_t* pcm, const int32_t* pos, const int32_t* frac,
+                     const int16_t* env, int16_t* out, int count);
+
+    // out[k] = in[k] * env[k] >> 15 (noise voices skip interpolation)
+    void scale(const int16_t* in, const int16_t* env, int16_t* out, int count);
+
+    // acc[k] += in[k] * vol[k] >> 15
+    void accumulate(const int16_t* in, const int16_t* vol, int32_t* acc, int count);
+
+    // Name of the kernels compiled into this build (scalar / sse2 / avx2)
+    const char* backend();
+
+}
@@ -0,0 +1,212 @@
+/*
+    Description: SPU (Sound Processing Unit) Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "command_ring.hpp"
+#include "dma.hpp"
+
+class Bus;
+
+// Consumer of mixed 44.1 kHz frames (interleaved L/R int16). Frames are handed
+// over once per mixed batch from whichever thread runs the mixer. A sink without
+// a `write` callback is the null sink: output is mixed and discarded.
+struct AudioSink {
+    void* ctx = nullptr;
+    void (*write)(void* ctx, const int16_t* frames, uint32_t count) = nullptr;
+};
+
+// The SPU is never stepped per sample. Register writes are stamped with the sample
+// they land on, and the mixer renders everything in between as one batch: all 24
+// voices over the whole run, then reverb and the master mix. The scheduler only
+// fires once per batch to keep the output flowing while no registers are touched.
+class SPU {
+    public:
+        SPU(Bus* bus);
+        ~SPU();
+
+        void init();
+
+        // Register interface (offset relative to 0x1F801C00, halfword registers)
+        uint16_t read16(uint32_t offset);
+        void write16(uint32_t offset, uint16_t data);
+
+        // Move mixing onto a dedicated audio thread. Writes are then queued in order
+        // with the elapsed sample counts; the emulation thread only waits in sync().
+        void setThreaded(bool enable);
+        bool isThreaded() const { return threaded; }
+
+        void connectAudio(const AudioSink& sink);
+
+        // Block until every elapsed sample has been mixed and every write applied
+        void sync();
+
+        // DMA channel 4 endpoint
+        DMAPort dmaPort();
+
+    private:
+        static constexpr int VOICE_COUNT = 24;
+        static constexpr uint32_t RAM_SIZE = 512 * 1024;
+        static constexpr uint32_t RAM_MASK = RAM_SIZE - 1;
+
+        // 33.8688 MHz / 44.1 kHz
+        static constexpr uint32_t CYCLES_PER_SAMPLE = 768;
+
+        // Samples mixed per scheduled batch (~5.8 ms)
+        static constexpr uint32_t BATCH_SAMPLES = 256;
+
+        // Mixer working set: longer runs are mixed in chunks of this size
+        static constexpr int CHUNK = 256;
+
+        // Decoded samples one voice can consume in a chunk (pitch is capped at 4x)
+        static constexpr int PCM_CAPACITY = 3 + 28 * (CHUNK * 4 / 28 + 2);
+
+        // Noise LFSR value after reset
+        static constexpr uint16_t NOISE_SEED = 1;
+
+        // Ring entry tags
+        static constexpr uint8_t RING_RUN = 0;      // [samples]
+        static constexpr uint8_t RING_WRITE = 1;    // [offset << 16 | value]
+        static constexpr uint8_t RING_RAM = 2;      // [address, halfwords, data...]
+
+        enum class Phase : uint8_t { Off, Attack, Decay, Sustain, Release };
+
+        // Shared stepping rule of ADSR phases and volume sweeps
+        struct Envelope {
+            int32_t counter;
+            uint8_t rate;           // Shift << 2 | step
+            bool decreasing;
+            bool exponential;
+
+            void reset(uint8_t new_rate, bool dec, bool exp);
+            int16_t tick(int16_t level);
+        };
+
+        // Voice/main volume: fixed, or sweeping when bit 15 of the register is set
+        struct Volume {
+            int16_t level;
+            bool sweep;
+            bool negative;
+            Envelope env;
+
+            void set(uint16_t value);
+            int16_t tick();
+        };
+
+        struct Voice {
+            Volume vol_l, vol_r;
+            uint16_t pitch;
+            uint32_t start;         // Byte addresses
+            uint32_t repeat;
+            uint16_t adsr_lo, adsr_hi;
+
+            uint32_t address;       // Current ADPCM block
+            uint32_t counter;       // 12.12 sample position inside the block
+            bool ignore_repeat;     // Repeat address was set by software after key on
+
+            Phase phase;
+            int16_t level;
+            Envelope adsr;
+
+            // Three samples of the previous block followed by the current block
+            std::array<int16_t, 3 + 28> window;
+            int32_t old, older;     // ADPCM filter history
+        };
+
+        // --- Emulation thread side ---
+        void catchUp();
+        void scheduleBatch();
+        void flushFifo();
+        void submitRun(uint32_t samples);
+        void submitWrite(uint32_t offset, uint16_t value);
+        void submitRAM(uint32_t address, const void* data, uint32_t count);
+        uint16_t status() const;
+        void audioLoop();
+
+        static void onBatch(void* ctx, uint64_t now);
+        static void dmaToDevice(void* ctx, const uint32_t* words, uint32_t count);
+        static void dmaFromDevice(void* ctx, uint32_t* words, uint32_t count);
+
+        // --- Mixer side (audio thread when threaded) ---
+        void render(uint32_t samples);
+        void mixChunk(int count);
+        void renderVoice(int index, int count);
+        void decodeBlock(Voice& voice, int16_t* out);
+        void endOfBlock(int index);
+        void tickADSR(Voice& voice);
+        void updateEnvelope(Voice& voice);
+        void keyOn(int index);
+        void keyOff(int index);
+        void stepNoise(int count);
+        void reverb(int32_t in_l, int32_t in_r);
+        uint32_t reverbAddress(uint16_t reg, int32_t delta) const;
+        void applyWrite(uint32_t offset, uint16_t value);
+        void writeRAM(uint32_t address, const void* data, uint32_t count);
+        void checkIRQ(uint32_t address, uint32_t size);
+
+        Bus* bus = nullptr;
+
+        bool threaded = false;
+        std::unique_ptr<CommandRing> ring;
+        std::thread audio_thread;
+
+        // --- Emulation side state ---
+        std::array<uint16_t, 0x200> regs;       // Read-back copy of written registers
+        uint64_t last_sync = 0;                 // Timestamp of the last queued sample
+        uint32_t transfer_addr = 0;
+        std::vector<uint16_t> fifo;             // Manual transfer words not yet queued
+        uint32_t fifo_addr = 0;
+        std::vector<uint32_t> staging;          // RING_RAM entry being built
+        uint32_t irq_epoch = 0;                 // SPUCNT IRQ disables written so far
+
+        // --- Published by the mixer for register reads ---
+        std::atomic<uint32_t> endx{0};
+        std::array<std::atomic<uint16_t>, VOICE_COUNT> adsr_levels;
+        // IRQ9 flag, as the mixer's IRQ epoch + 1 when it was raised (0: never).
+        // It only reads as set while the emulation side is still in that epoch,
+        // so a flag raised before an acknowledge the mixer has yet to apply is
+        // never seen after the IRQ is re-enabled.
+        std::atomic<uint32_t> irq_raised{0};
+        std::atomic<bool> capture_half{false};
+
+        // --- Mixer state ---
+        std::vector<uint16_t> ram;
+        std::array<Voice, VOICE_COUNT> voices;
+        AudioSink sink;
+
+        uint16_t control = 0;                   // SPUCNT
+        Volume main_l, main_r;
+        int16_t reverb_vol_l = 0, reverb_vol_r = 0;
+        uint32_t pmon = 0, non = 0, eon = 0;
+        uint32_t irq_addr = 0;
+        uint32_t mixer_irq_epoch = 0;
+
+        uint16_t noise_level = NOISE_SEED;
+        int32_t noise_timer = 0;
+        uint32_t capture_index = 0;
+
+        // Reverb: registers 0x1C0-0x1FE, processed at 22.05 kHz
+        std::array<uint16_t, 32> reverb_regs;
+        uint32_t reverb_base = 0, reverb_current = 0;
+        bool reverb_odd = false;
+        int32_t reverb_in_l = 0, reverb_in_r = 0;
+        int32_t reverb_out_l = 0, reverb_out_r = 0;
+
+        // Chunk buffers
+        alignas(32) std::array<std::array<int16_t, CHUNK>, VOICE_COUNT> voice_out;
+        alignas(32) std::array<int16_t, PCM_CAPACITY> pcm;
+        alignas(32) std::array<int32_t, CHUNK> pos, frac;
+        alignas(32) std::array<int16_t, CHUNK> env, vol_l, vol_r, noise;
+        alignas(32) std::array<int32_t, CHUNK> mix_l, mix_r, rev_l, rev_r;
+        std::array<int16_t, CHUNK * 2> frames;
+};
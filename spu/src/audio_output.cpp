@@ -0,0 +1,90 @@
+/*
+    Description: SDL Audio Output Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "audio_output.hpp"
+#include <SDL2/SDL.h>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    constexpr int SAMPLE_RATE = 44100;
+
+    // Device buffer: ~11.6 ms per callback
+    constexpr uint16_t DEVICE_FRAMES = 512;
+
+    // ~185 ms of headroom for emulation speed jitter
+    constexpr size_t RING_FRAMES = 8192;
+}
+
+AudioOutput::AudioOutput() : ring(RING_FRAMES) {}
+
+AudioOutput::~AudioOutput() {
+    close();
+}
+
+bool AudioOutput::open() {
+    if (device) return true;
+
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) != 0) {
+        std::cerr << "[Audio] SDL audio init failed: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    SDL_AudioSpec want;
+    std::memset(&want, 0, sizeof(want));
+    want.freq = SAMPLE_RATE;
+    want.format = AUDIO_S16SYS;
+    want.channels = 2;
+    want.samples = DEVICE_FRAMES;
+    want.callback = &AudioOutput::callback;
+    want.userdata = this;
+
+    SDL_AudioSpec have;
+    device = SDL_OpenAudioDevice(nullptr, 0, &want, &have, 0);
+    if (device == 0) {
+        std::cerr << "[Audio] Failed to open audio device: " << SDL_GetError() << std::endl;
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return false;
+    }
+
+    SDL_PauseAudioDevice(device, 0);
+    return true;
+}
+
+void AudioOutput::close() {
+    if (!device) return;
+
+    SDL_CloseAudioDevice(device);
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    device = 0;
+}
+
+AudioSink AudioOutput::sink() {
+    AudioSink sink;
+    sink.ctx = this;
+    sink.write = &AudioOutput::sinkWrite;
+    return sink;
+}
+
+void AudioOutput::sinkWrite(void* ctx, const int16_t* frames, uint32_t count) {
+    AudioOutput* out = static_cast<AudioOutput*>(ctx);
+    const size_t written = out->ring.write(frames, count);
+    if (written < count) {
+        out->overruns.fetch_add(count - written, std::memory_order_relaxed);
+    }
+}
+
+void AudioOutput::callback(void* userdata, uint8_t* stream, int len) {
+    AudioOutput* out = static_cast<AudioOutput*>(userdata);
+    int16_t* frames = reinterpret_cast<int16_t*>(stream);
+    const size_t wanted = static_cast<size_t>(len) / (2 * sizeof(int16_t));
+
+    const size_t got = out->ring.read(frames, wanted);
+    if (got < wanted) {
+        std::memset(frames + got * 2, 0, (wanted - got) * 2 * sizeof(int16_t));
+        out->underruns.fetch_add(wanted - got, std::memory_order_relaxed);
+    }
+}
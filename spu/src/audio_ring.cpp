@@ -0,0 +1,46 @@
+/*
+    Description: Single-Producer / Single-Consumer Audio Frame Ring Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "audio_ring.hpp"
+#include <algorithm>
+#include <cstring>
+
+AudioRing::AudioRing(size_t capacity_frames) {
+    // Round up to a power of two so positions can be masked
+    capacity = 1;
+    while (capacity < capacity_frames) capacity <<= 1;
+    mask = capacity - 1;
+    buffer.resize(capacity * 2);
+}
+
+AudioRing::~AudioRing() = default;
+
+size_t AudioRing::write(const int16_t* frames, size_t count) {
+    const uint64_t write = write_pos.load(std::memory_order_relaxed);
+    const uint64_t used = write - read_pos.load(std::memory_order_acquire);
+    count = std::min<size_t>(count, capacity - used);
+
+    const size_t start = write & mask;
+    const size_t first = std::min(count, capacity - start);
+    std::memcpy(&buffer[start * 2], frames, first * 2 * sizeof(int16_t));
+    std::memcpy(&buffer[0], frames + first * 2, (count - first) * 2 * sizeof(int16_t));
+
+    write_pos.store(write + count, std::memory_order_release);
+    return count;
+}
+
+size_t AudioRing::read(int16_t* frames, size_t count) {
+    const uint64_t read = read_pos.load(std::memory_order_relaxed);
+    count = std::min<size_t>(count, write_pos.load(std::memory_order_acquire) - read);
+
+    const size_t start = read & mask;
+    const size_t first = std::min(count, capacity - start);
+    std::memcpy(frames, &buffer[start * 2], first * 2 * sizeof(int16_t));
+    std::memcpy(frames + first * 2, &buffer[0], (count - first) * 2 * sizeof(int16_t));
+
+    read_pos.store(read + count, std::memory_order_release);
+    return count;
+}
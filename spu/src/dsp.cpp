@@ -0,0 +1,358 @@
+/*
+    Description: SPU Voice DSP Kernels Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "dsp.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DSP_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define DSP_SSE2 1
+#endif
+
+namespace DSP {
+
+namespace {
+
+    constexpr int LANES = 8;
+
+    // ADPCM prediction filters (filters 5-7 behave like 4)
+    constexpr int32_t FILTER_POS[5] = {0, 60, 115, 98, 122};
+    constexpr int32_t FILTER_NEG[5] = {0, 0, -52, -55, -60};
+
+    // Hardware Gaussian interpolation table
+    constexpr int16_t GAUSS[512] = {
+        -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001,
+        -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001, -0x001,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0001,
+        0x0001, 0x0001, 0x0001, 0x0002, 0x0002, 0x0002, 0x0003, 0x0003,
+        0x0003, 0x0004, 0x0004, 0x0005, 0x0005, 0x0006, 0x0007, 0x0007,
+        0x0008, 0x0009, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E,
+        0x000F, 0x0010, 0x0011, 0x0012, 0x0013, 0x0015, 0x0016, 0x0018,
+        0x0019, 0x001B, 0x001C, 0x001E, 0x0020, 0x0021, 0x0023, 0x0025,
+        0x0027, 0x0029, 0x002C, 0x002E, 0x0030, 0x0033, 0x0035, 0x0038,
+        0x003A, 0x003D, 0x0040, 0x0043, 0x0046, 0x0049, 0x004D, 0x0050,
+        0x0054, 0x0057, 0x005B, 0x005F, 0x0063, 0x0067, 0x006B, 0x006F,
+        0x0074, 0x0078, 0x007D, 0x0082, 0x0087, 0x008C, 0x0091, 0x0096,
+        0x009C, 0x00A1, 0x00A7, 0x00AD, 0x00B3, 0x00BA, 0x00C0, 0x00C7,
+        0x00CD, 0x00D4, 0x00DB, 0x00E3, 0x00EA, 0x00F2, 0x00FA, 0x0101,
+        0x010A, 0x0112, 0x011B, 0x0123, 0x012C, 0x0135, 0x013F, 0x0148,
+        0x0152, 0x015C, 0x0166, 0x0171, 0x017B, 0x0186, 0x0191, 0x019C,
+        0x01A8, 0x01B4, 0x01C0, 0x01CC, 0x01D9, 0x01E5, 0x01F2, 0x0200,
+        0x020D, 0x021B, 0x0229, 0x0237, 0x0246, 0x0255, 0x0264, 0x0273,
+        0x0283, 0x0293, 0x02A3, 0x02B4, 0x02C4, 0x02D6, 0x02E7, 0x02F9,
+        0x030B, 0x031D, 0x0330, 0x0343, 0x0356, 0x036A, 0x037E, 0x0392,
+        0x03A7, 0x03BC, 0x03D1, 0x03E7, 0x03FC, 0x0413, 0x042A, 0x0441,
+        0x0458, 0x0470, 0x0488, 0x04A0, 0x04B9, 0x04D2, 0x04EC, 0x0506,
+        0x0520, 0x053B, 0x0556, 0x0572, 0x058E, 0x05AA, 0x05C7, 0x05E4,
+        0x0601, 0x061F, 0x063E, 0x065C, 0x067C, 0x069B, 0x06BB, 0x06DC,
+        0x06FD, 0x071E, 0x0740, 0x0762, 0x0784, 0x07A7, 0x07CB, 0x07EF,
+        0x0813, 0x0838, 0x085D, 0x0883, 0x08A9, 0x08D0, 0x08F7, 0x091E,
+        0x0946, 0x096F, 0x0998, 0x09C1, 0x09EB, 0x0A16, 0x0A40, 0x0A6C,
+        0x0A98, 0x0AC4, 0x0AF1, 0x0B1E, 0x0B4C, 0x0B7A, 0x0BA9, 0x0BD8,
+        0x0C07, 0x0C38, 0x0C68, 0x0C99, 0x0CCB, 0x0CFD, 0x0D30, 0x0D63,
+        0x0D97, 0x0DCB, 0x0E00, 0x0E35, 0x0E6B, 0x0EA1, 0x0ED7, 0x0F0F,
+        0x0F46, 0x0F7F, 0x0FB7, 0x0FF1, 0x102A, 0x1065, 0x109F, 0x10DB,
+        0x1116, 0x1153, 0x118F, 0x11CD, 0x120B, 0x1249, 0x1288, 0x12C7,
+        0x1307, 0x1347, 0x1388, 0x13C9, 0x140B, 0x144D, 0x1490, 0x14D4,
+        0x1517, 0x155C, 0x15A0, 0x15E6, 0x162C, 0x1672, 0x16B9, 0x1700,
+        0x1747, 0x1790, 0x17D8, 0x1821, 0x186B, 0x18B5, 0x1900, 0x194B,
+        0x1996, 0x19E2, 0x1A2E, 0x1A7B, 0x1AC8, 0x1B16, 0x1B64, 0x1BB3,
+        0x1C02, 0x1C51, 0x1CA1, 0x1CF1, 0x1D42, 0x1D93, 0x1DE5, 0x1E37,
+        0x1E89, 0x1EDC, 0x1F2F, 0x1F82, 0x1FD6, 0x202A, 0x207F, 0x20D4,
+        0x2129, 0x217F, 0x21D5, 0x222C, 0x2282, 0x22DA, 0x2331, 0x2389,
+        0x23E1, 0x2439, 0x2492, 0x24EB, 0x2545, 0x259E, 0x25F8, 0x2653,
+        0x26AD, 0x2708, 0x2763, 0x27BE, 0x281A, 0x2876, 0x28D2, 0x292E,
+        0x298B, 0x29E7, 0x2A44, 0x2AA1, 0x2AFF, 0x2B5C, 0x2BBA, 0x2C18,
+        0x2C76, 0x2CD4, 0x2D33, 0x2D91, 0x2DF0, 0x2E4F, 0x2EAE, 0x2F0D,
+        0x2F6C, 0x2FCC, 0x302B, 0x308B, 0x30EA, 0x314A, 0x31AA, 0x3209,
+        0x3269, 0x32C9, 0x3329, 0x3389, 0x33E9, 0x3449, 0x34A9, 0x3509,
+        0x3569, 0x35C9, 0x3629, 0x3689, 0x36E8, 0x3748, 0x37A8, 0x3807,
+        0x3867, 0x38C6, 0x3926, 0x3985, 0x39E4, 0x3A43, 0x3AA2, 0x3B00,
+        0x3B5F, 0x3BBD, 0x3C1B, 0x3C79, 0x3CD7, 0x3D34, 0x3D92, 0x3DEF,
+        0x3E4C, 0x3EA8, 0x3F05, 0x3F61, 0x3FBD, 0x4018, 0x4074, 0x40CF,
+        0x4129, 0x4184, 0x41DE, 0x4237, 0x4291, 0x42EA, 0x4342, 0x439B,
+        0x43F3, 0x444A, 0x44A1, 0x44F8, 0x454E, 0x45A4, 0x45FA, 0x464F,
+        0x46A4, 0x46F8, 0x474B, 0x479F, 0x47F2, 0x4844, 0x4896, 0x48E8,
+        0x4939, 0x4989, 0x49D9, 0x4A29, 0x4A78, 0x4AC6, 0x4B14, 0x4B62,
+        0x4BAF, 0x4BFB, 0x4C47, 0x4C93, 0x4CDD, 0x4D28, 0x4D72, 0x4DBB,
+        0x4E03, 0x4E4B, 0x4E93, 0x4EDA, 0x4F20, 0x4F66, 0x4FAB, 0x4FF0,
+        0x5034, 0x5077, 0x50BA, 0x50FC, 0x513E, 0x517F, 0x51BF, 0x51FF,
+        0x523E, 0x527D, 0x52BB, 0x52F8, 0x5335, 0x5371, 0x53AC, 0x53E7,
+        0x5421, 0x545A, 0x5493, 0x54CB, 0x5502, 0x5539, 0x556F, 0x55A4,
+        0x55D9, 0x560D, 0x5640, 0x5673, 0x56A5, 0x56D6, 0x5707, 0x5737,
+        0x5766, 0x5794, 0x57C2, 0x57EF, 0x581B, 0x5847, 0x5872, 0x589C,
+        0x58C5, 0x58EE, 0x5916, 0x593D, 0x5964, 0x598A, 0x59AF, 0x59D3,
+        0x59F7, 0x5A1A, 0x5A3C, 0x5A5D, 0x5A7E, 0x5A9E, 0x5ABD, 0x5ADC,
+        0x5AFA, 0x5B17, 0x5B33, 0x5B4F, 0x5B6A, 0x5B84, 0x5B9D, 0x5BB6,
+        0x5BCE, 0x5BE5, 0x5BFB, 0x5C11, 0x5C26, 0x5C3A, 0x5C4D, 0x5C60,
+    };
+
+    // The four coefficients of each interpolation phase, ordered oldest tap first,
+    // so one 64-bit load fetches a whole row
+    struct GaussRows {
+        alignas(16) int16_t row[256][4];
+    };
+
+    constexpr GaussRows makeGaussRows() {
+        GaussRows t{};
+        for (int i = 0; i < 256; i++) {
+            t.row[i][0] = GAUSS[0x0FF - i];
+            t.row[i][1] = GAUSS[0x1FF - i];
+            t.row[i][2] = GAUSS[0x100 + i];
+            t.row[i][3] = GAUSS[i];
+        }
+        return t;
+    }
+
+    constexpr GaussRows GAUSS_ROWS = makeGaussRows();
+
+    inline int32_t clamp16(int32_t x) {
+        return std::clamp<int32_t>(x, -0x8000, 0x7FFF);
+    }
+
+    // --- Scalar reference kernels ---
+
+    // raw[4 + n] receives sample n; raw[0-3] line up with the two header bytes
+    [[maybe_unused]] void expandNibblesScalar(const uint8_t* block, int shift, int16_t* raw) {
+        for (int i = 0; i < SAMPLES_PER_BLOCK / 2; i++) {
+            const uint8_t b = block[2 + i];
+            raw[4 + i * 2] = static_cast<int16_t>(static_cast<int16_t>((b & 0x0F) << 12) >> shift);
+            raw[5 + i * 2] = static_cast<int16_t>(static_cast<int16_t>((b & 0xF0) << 8) >> shift);
+        }
+    }
+
+    [[maybe_unused]] void interpolateScalar(const int16_t* pcm, const int32_t* pos, const int32_t* frac,
+                                            const int16_t* env, int16_t* out, int count) {
+        for (int k = 0; k < count; k++) {
+            const int16_t* taps = pcm + pos[k];
+            const int16_t* g = GAUSS_ROWS.row[frac[k]];
+            int32_t sum = 0;
+            for (int t = 0; t < 4; t++) {
+                sum += (g[t] * taps[t]) >> 15;
+            }
+            out[k] = static_cast<int16_t>((clamp16(sum) * env[k]) >> 15);
+        }
+    }
+
+    [[maybe_unused]] void scaleScalar(const int16_t* in, const int16_t* env, int16_t* out, int count) {
+        for (int k = 0; k < count; k++) {
+            out[k] = static_cast<int16_t>(clamp16((in[k] * env[k]) >> 15));
+        }
+    }
+
+    [[maybe_unused]] void accumulateScalar(const int16_t* in, const int16_t* vol, int32_t* acc, int count) {
+        for (int k = 0; k < count; k++) {
+            acc[k] += (in[k] * vol[k]) >> 15;
+        }
+    }
+
+#if defined(DSP_AVX2) || defined(DSP_SSE2)
+
+    inline __m128i load(const void* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline void store(void* p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    inline __m128i load64(const void* p) { return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)); }
+
+    // Full 32-bit products of eight int16 pairs, SAR 15, in two halves
+    inline void mulShift15(__m128i a, __m128i b, __m128i& first, __m128i& second) {
+        const __m128i lo = _mm_mullo_epi16(a, b);
+        const __m128i hi = _mm_mulhi_epi16(a, b);
+        first = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 15);
+        second = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 15);
+    }
+
+    inline __m128i mulShift15(__m128i a, __m128i b) {
+        __m128i first, second;
+        mulShift15(a, b, first, second);
+        return _mm_packs_epi32(first, second);
+    }
+
+    // Both nibbles of the 16 block bytes in sample order: raw[4 + n] is sample n
+    void expandNibblesSIMD(const uint8_t* block, int shift, int16_t* raw) {
+        const __m128i bytes = load(block);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i count = _mm_cvtsi32_si128(shift);
+
+        for (int half = 0; half < 2; half++) {
+            const __m128i b = half ? _mm_unpackhi_epi8(bytes, zero) : _mm_unpacklo_epi8(bytes, zero);
+            const __m128i lo = _mm_slli_epi16(_mm_and_si128(b, _mm_set1_epi16(0x0F)), 12);
+            const __m128i hi = _mm_slli_epi16(_mm_and_si128(b, _mm_set1_epi16(0xF0)), 8);
+            store(raw + half * 16, _mm_sra_epi16(_mm_unpacklo_epi16(lo, hi), count));
+            store(raw + half * 16 + 8, _mm_sra_epi16(_mm_unpackhi_epi16(lo, hi), count));
+        }
+    }
+
+#endif
+
+#if defined(DSP_AVX2)
+
+    // Pairwise sums of four samples' products: 128-bit lane 0 holds samples 0/1, lane 1 samples 2/3
+    inline __m256i gaussPartial(const int16_t* pcm, const int32_t* pos, const int32_t* frac) {
+        const __m256i taps = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(pcm), load(pos), 2);
+        const __m256i coef = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(GAUSS_ROWS.row), load(frac), 8);
+        const __m256i lo = _mm256_mullo_epi16(taps, coef);
+        const __m256i hi = _mm256_mulhi_epi16(taps, coef);
+        const __m256i even = _mm256_srai_epi32(_mm256_unpacklo_epi16(lo, hi), 15);
+        const __m256i odd = _mm256_srai_epi32(_mm256_unpackhi_epi16(lo, hi), 15);
+        return _mm256_hadd_epi32(even, odd);
+    }
+
+    void interpolateSIMD(const int16_t* pcm, const int32_t* pos, const int32_t* frac,
+                         const int16_t* env, int16_t* out, int count) {
+        const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+        int k = 0;
+        for (; k + LANES <= count; k += LANES) {
+            __m256i sum = _mm256_hadd_epi32(gaussPartial(pcm, pos + k, frac + k), gaussPartial(pcm, pos + k + 4, frac + k + 4));
+            sum = _mm256_permutevar8x32_epi32(sum, order);
+            sum = _mm256_min_epi32(_mm256_max_epi32(sum, _mm256_set1_epi32(-0x8000)), _mm256_set1_epi32(0x7FFF));
+
+            const __m256i level = _mm256_cvtepi16_epi32(load(env + k));
+            const __m256i scaled = _mm256_srai_epi32(_mm256_mullo_epi32(sum, level), 15);
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(scaled, scaled), 0x08);
+            store(out + k, _mm256_castsi256_si128(packed));
+        }
+        interpolateScalar(pcm, pos + k, frac + k, env + k, out + k, count - k);
+    }
+
+    void accumulateSIMD(const int16_t* in, const int16_t* vol, int32_t* acc, int count) {
+        int k = 0;
+        for (; k + LANES <= count; k += LANES) {
+            const __m256i x = _mm256_cvtepi16_epi32(load(in + k));
+            const __m256i v = _mm256_cvtepi16_epi32(load(vol + k));
+            __m256i* dst = reinterpret_cast<__m256i*>(acc + k);
+            _mm256_storeu_si256(dst, _mm256_add_epi32(_mm256_loadu_si256(dst), _mm256_srai_epi32(_mm256_mullo_epi32(x, v), 15)));
+        }
+        accumulateScalar(in + k, vol + k, acc + k, count - k);
+    }
+
+#elif defined(DSP_SSE2)
+
+    // Sums of four samples' products, one sample per lane
+    inline __m128i gaussSum(const int16_t* pcm, const int32_t* pos, const int32_t* frac) {
+        __m128i products[4];
+        for (int k = 0; k < 4; k += 2) {
+            const __m128i taps = _mm_unpacklo_epi64(load64(pcm + pos[k]), load64(pcm + pos[k + 1]));
+            const __m128i coef = _mm_unpacklo_epi64(load64(GAUSS_ROWS.row[frac[k]]), load64(GAUSS_ROWS.row[frac[k + 1]]));
+            mulShift15(taps, coef, products[k], products[k + 1]);
+        }
+
+        // Transpose-add so lane k ends up with the sum of sample k's four products
+        const __m128i s01 = _mm_add_epi32(_mm_unpacklo_epi32(products[0], products[1]), _mm_unpackhi_epi32(products[0], products[1]));
+        const __m128i s23 = _mm_add_epi32(_mm_unpacklo_epi32(products[2], products[3]), _mm_unpackhi_epi32(products[2], products[3]));
+        return _mm_add_epi32(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+    }
+
+    void interpolateSIMD(const int16_t* pcm, const int32_t* pos, const int32_t* frac,
+                         const int16_t* env, int16_t* out, int count) {
+        int k = 0;
+        for (; k + LANES <= count; k += LANES) {
+            const __m128i sum = _mm_packs_epi32(gaussSum(pcm, pos + k, frac + k), gaussSum(pcm, pos + k + 4, frac + k + 4));
+            store(out + k, mulShift15(sum, load(env + k)));
+        }
+        interpolateScalar(pcm, pos + k, frac + k, env + k, out + k, count - k);
+    }
+
+    void accumulateSIMD(const int16_t* in, const int16_t* vol, int32_t* acc, int count) {
+        int k = 0;
+        for (; k + LANES <= count; k += LANES) {
+            __m128i first, second;
+            mulShift15(load(in + k), load(vol + k), first, second);
+            store(acc + k, _mm_add_epi32(load(acc + k), first));
+            store(acc + k + 4, _mm_add_epi32(load(acc + k + 4), second));
+        }
+        accumulateScalar(in + k, vol + k, acc + k, count - k);
+    }
+
+#endif
+
+#if defined(DSP_AVX2) || defined(DSP_SSE2)
+
+    void scaleSIMD(const int16_t* in, const int16_t* env, int16_t* out, int count) {
+        int k = 0;
+        for (; k + LANES <= count; k += LANES) {
+            store(out + k, mulShift15(load(in + k), load(env + k)));
+        }
+        scaleScalar(in + k, env + k, out + k, count - k);
+    }
+
+#endif
+
+}
+
+void decodeBlock(const uint8_t* block, int16_t* out, int32_t& old, int32_t& older) {
+    const int shift = (block[0] & 0xF) > 12 ? 9 : (block[0] & 0xF);
+    const int filter = std::min((block[0] >> 4) & 7, 4);
+
+    alignas(16) int16_t raw[32];
+#if defined(DSP_AVX2) || defined(DSP_SSE2)
+    expandNibblesSIMD(block, shift, raw);
+#ifdef DEBUG
+    int16_t ref[32];
+    expandNibblesScalar(block, shift, ref);
+    assert(std::memcmp(raw + 4, ref + 4, SAMPLES_PER_BLOCK * sizeof(int16_t)) == 0);
+#endif
+#else
+    expandNibblesScalar(block, shift, raw);
+#endif
+
+    // The prediction filter is recursive, so this part stays sample by sample
+    const int32_t pos = FILTER_POS[filter];
+    const int32_t neg = FILTER_NEG[filter];
+    for (int n = 0; n < SAMPLES_PER_BLOCK; n++) {
+        const int32_t sample = clamp16(raw[4 + n] + ((old * pos + older * neg + 32) >> 6));
+        out[n] = static_cast<int16_t>(sample);
+        older = old;
+        old = sample;
+    }
+}
+
+void interpolate(const int16_t* pcm, const int32_t* pos, const int32_t* frac,
+                 const int16_t* env, int16_t* out, int count) {
+#if defined(DSP_AVX2) || defined(DSP_SSE2)
+    interpolateSIMD(pcm, pos, frac, env, out, count);
+#ifdef DEBUG
+    // Check the vector kernel against the reference on every call in debug builds
+    std::vector<int16_t> ref(count);
+    interpolateScalar(pcm, pos, frac, env, ref.data(), count);
+    assert(std::equal(ref.begin(), ref.end(), out));
+#endif
+#else
+    interpolateScalar(pcm, pos, frac, env, out, count);
+#endif
+}
+
+void scale(const int16_t* in, const int16_t* env, int16_t* out, int count) {
+#if defined(DSP_AVX2) || defined(DSP_SSE2)
+    scaleSIMD(in, env, out, count);
+#else
+    scaleScalar(in, env, out, count);
+#endif
+}
+
+void accumulate(const int16_t* in, const int16_t* vol, int32_t* acc, int count) {
+#if defined(DSP_AVX2) || defined(DSP_SSE2)
+    accumulateSIMD(in, vol, acc, count);
+#else
+    accumulateScalar(in, vol, acc, count);
+#endif
+}
+
+const char* backend() {
+#if defined(DSP_AVX2)
+    return "avx2";
+#elif defined(DSP_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+}
@@ -0,0 +1,780 @@
+/*
+    Description: SPU (Sound Processing Unit) Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "spu.hpp"
+#include "bus.hpp"
+#include "dsp.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // SPUCNT fields
+    constexpr uint16_t CNT_ENABLE = 1u << 15;
+    constexpr uint16_t CNT_UNMUTE = 1u << 14;
+    constexpr uint16_t CNT_REVERB = 1u << 7;
+    constexpr uint16_t CNT_IRQ    = 1u << 6;
+
+    // ADPCM block header flags
+    constexpr uint8_t BLOCK_LOOP_END    = 1u << 0;
+    constexpr uint8_t BLOCK_LOOP_REPEAT = 1u << 1;
+    constexpr uint8_t BLOCK_LOOP_START  = 1u << 2;
+
+    // Reverb registers (0x1C0 + 2 * n), named as in the hardware docs
+    enum ReverbReg {
+        dAPF1, dAPF2, vIIR, vCOMB1, vCOMB2, vCOMB3, vCOMB4, vWALL,
+        vAPF1, vAPF2, mLSAME, mRSAME, mLCOMB1, mRCOMB1, mLCOMB2, mRCOMB2,
+        dLSAME, dRSAME, mLDIFF, mRDIFF, mLCOMB3, mRCOMB3, mLCOMB4, mRCOMB4,
+        dLDIFF, dRDIFF, mLAPF1, mRAPF1, mLAPF2, mRAPF2, vLIN, vRIN,
+    };
+
+    // Capture buffers (halfword index): CD left/right, voice 1, voice 3
+    constexpr uint32_t CAPTURE_CD_L = 0x000, CAPTURE_CD_R = 0x200;
+    constexpr uint32_t CAPTURE_VOICE1 = 0x400, CAPTURE_VOICE3 = 0x600;
+
+    // 256KB of queued writes and uploads; a batch of samples is a single word
+    constexpr size_t RING_WORDS = 1 << 16;
+
+    // Uploads are split so one ring entry stays well under half the ring
+    constexpr uint32_t RAM_CHUNK_HALFWORDS = 8192;
+
+    // Manual transfer words are queued in runs of at most this many
+    constexpr size_t FIFO_FLUSH = 4096;
+
+    inline int32_t clamp16(int32_t x) {
+        return std::clamp<int32_t>(x, -0x8000, 0x7FFF);
+    }
+
+    inline int32_t mul15(int32_t a, int32_t b) {
+        return (a * b) >> 15;
+    }
+
+    inline void setHalf(uint32_t& mask, uint32_t offset, uint16_t value) {
+        const uint32_t shift = (offset & 2) ? 16 : 0;
+        mask = ((mask & ~(0xFFFFu << shift)) | (static_cast<uint32_t>(value) << shift)) & 0xFFFFFF;
+    }
+
+    inline int32_t sustainLevel(uint16_t adsr_lo) {
+        return std::min<int32_t>(((adsr_lo & 0xF) + 1) * 0x800, 0x7FFF);
+    }
+}
+
+// --- Envelopes ---
+
+void SPU::Envelope::reset(uint8_t new_rate, bool dec, bool exp) {
+    counter = 0;
+    rate = new_rate & 0x7F;
+    decreasing = dec;
+    exponential = exp;
+}
+
+int16_t SPU::Envelope::tick(int16_t level) {
+    const int shift = rate >> 2;
+    int32_t step = decreasing ? -8 + (rate & 3) : 7 - (rate & 3);
+    int32_t cycles = 1 << std::max(0, shift - 11);
+    step *= 1 << std::max(0, 11 - shift);
+
+    if (exponential) {
+        if (decreasing) {
+            step = (step * level) >> 15;
+        } else if (level > 0x6000) {
+            cycles *= 4;
+        }
+    }
+
+    if (--counter > 0) return level;
+    counter = cycles;
+    return static_cast<int16_t>(std::clamp<int32_t>(level + step, 0, 0x7FFF));
+}
+
+void SPU::Volume::set(uint16_t value) {
+    sweep = (value & 0x8000) != 0;
+    if (!sweep) {
+        level = static_cast<int16_t>(value << 1);
+        negative = false;
+        return;
+    }
+
+    // Sweeps move the magnitude from wherever the volume currently is
+    level = static_cast<int16_t>(std::min(std::abs(static_cast<int32_t>(level)), 0x7FFF));
+    negative = (value & 0x1000) != 0;
+    env.reset(value & 0x7F, (value & 0x2000) != 0, (value & 0x4000) != 0);
+}
+
+int16_t SPU::Volume::tick() {
+    if (!sweep) return level;
+    level = env.tick(level);
+    return negative ? static_cast<int16_t>(-level) : level;
+}
+
+// --- Emulation thread side ---
+
+SPU::SPU(Bus* bus) : bus(bus), ram(RAM_SIZE / 2, 0) {
+    init();
+}
+
+SPU::~SPU() {
+    setThreaded(false);
+}
+
+void SPU::init() {
+    regs.fill(0);
+    transfer_addr = 0;
+    fifo.clear();
+    fifo_addr = 0;
+
+    endx.store(0, std::memory_order_relaxed);
+    for (auto& level : adsr_levels) {
+        level.store(0, std::memory_order_relaxed);
+    }
+    irq_epoch = 0;
+    irq_raised.store(0, std::memory_order_relaxed);
+    capture_half.store(false, std::memory_order_relaxed);
+
+    std::fill(ram.begin(), ram.end(), 0);
+    for (auto& voice : voices) {
+        voice = Voice{};
+    }
+
+    control = 0;
+    main_l = Volume{};
+    main_r = Volume{};
+    reverb_vol_l = reverb_vol_r = 0;
+    pmon = non = eon = 0;
+    irq_addr = 0;
+    mixer_irq_epoch = 0;
+
+    noise_level = NOISE_SEED;
+    noise_timer = 0;
+    capture_index = 0;
+
+    reverb_regs.fill(0);
+    reverb_base = reverb_current = 0;
+    reverb_odd = false;
+    reverb_in_l = reverb_in_r = 0;
+    reverb_out_l = reverb_out_r = 0;
+
+    if (!bus) return;
+
+    last_sync = bus->scheduler.timestamp();
+    bus->scheduler.registerEvent(Event::SPU, &SPU::onBatch, this);
+    scheduleBatch();
+}
+
+DMAPort SPU::dmaPort() {
+    DMAPort port;
+    port.ctx = this;
+    port.toDevice = &SPU::dmaToDevice;
+    port.fromDevice = &SPU::dmaFromDevice;
+    return port;
+}
+
+void SPU::dmaToDevice(void* ctx, const uint32_t* words, uint32_t count) {
+    SPU* spu = static_cast<SPU*>(ctx);
+    spu->catchUp();
+    spu->flushFifo();
+    spu->submitRAM(spu->transfer_addr, words, count * 2);
+    spu->transfer_addr = (spu->transfer_addr + count * 4) & RAM_MASK;
+}
+
+void SPU::dmaFromDevice(void* ctx, uint32_t* words, uint32_t count) {
+    SPU* spu = static_cast<SPU*>(ctx);
+    spu->sync();
+
+    // The mixer is idle after sync(), so sound RAM can be read directly
+    uint8_t* dst = reinterpret_cast<uint8_t*>(words);
+    uint32_t index = spu->transfer_addr >> 1;
+    uint32_t remaining = count * 2;
+    while (remaining > 0) {
+        const uint32_t run = std::min(remaining, RAM_SIZE / 2 - index);
+        std::memcpy(dst, &spu->ram[index], run * 2);
+        dst += run * 2;
+        remaining -= run;
+        index = 0;
+    }
+    spu->transfer_addr = (spu->transfer_addr + count * 4) & RAM_MASK;
+}
+
+uint16_t SPU::read16(uint32_t offset) {
+    offset &= 0x3FE;
+
+    // Current ADSR volume
+    if (offset < 0x180 && (offset & 0xE) == 0xC) {
+        return adsr_levels[offset >> 4].load(std::memory_order_relaxed);
+    }
+
+    switch (offset) {
+        case 0x19C: return static_cast<uint16_t>(endx.load(std::memory_order_relaxed));
+        case 0x19E: return static_cast<uint16_t>(endx.load(std::memory_order_relaxed) >> 16);
+        case 0x1AE: return status();
+        default:    return regs[offset >> 1];
+    }
+}
+
+void SPU::write16(uint32_t offset, uint16_t data) {
+    offset &= 0x3FE;
+
+    // Everything up to this write is mixed with the old register values
+    catchUp();
+
+    switch (offset) {
+        case 0x188: case 0x18A: {
+            // Key on clears ENDX and the envelope immediately as far as reads can tell
+            uint32_t mask = 0;
+            setHalf(mask, offset, data);
+            endx.fetch_and(~mask, std::memory_order_relaxed);
+            for (int v = 0; v < VOICE_COUNT; v++) {
+                if (mask & (1u << v)) adsr_levels[v].store(0, std::memory_order_relaxed);
+            }
+            break;
+        }
+        case 0x19C: case 0x19E: case 0x1AE:
+            return;
+        case 0x1A6:
+            transfer_addr = (data * 8u) & RAM_MASK;
+            break;
+        case 0x1A8:
+            // Manual transfer: consecutive FIFO words are queued as one upload
+            if (fifo.empty()) fifo_addr = transfer_addr;
+            fifo.push_back(data);
+            transfer_addr = (transfer_addr + 2) & RAM_MASK;
+            regs[offset >> 1] = data;
+            if (fifo.size() >= FIFO_FLUSH) flushFifo();
+            return;
+        case 0x1AA:
+            // Clearing the enable bit acknowledges IRQ9 as of this write
+            if (!(data & CNT_IRQ)) irq_epoch++;
+            break;
+        default:
+            break;
+    }
+
+    regs[offset >> 1] = data;
+    flushFifo();
+    submitWrite(offset, data);
+}
+
+uint16_t SPU::status() const {
+    const uint16_t cnt = regs[0x1AA >> 1];
+    const uint32_t mode = (cnt >> 4) & 3;
+
+    uint16_t stat = cnt & 0x3F;
+    if ((cnt & CNT_IRQ) && irq_raised.load(std::memory_order_relaxed) == irq_epoch + 1) stat |= 1u << 6;
+    stat |= (cnt & 0x20) << 2;                  // DMA read/write request
+    if (mode == 2) stat |= 1u << 8;             // DMA write request
+    if (mode == 3) stat |= 1u << 9;             // DMA read request
+    if (capture_half.load(std::memory_order_relaxed)) stat |= 1u << 11;
+    return stat;
+}
+
+void SPU::setThreaded(bool enable) {
+    if (enable == threaded) return;
+
+    if (enable) {
+        ring = std::make_unique<CommandRing>(RING_WORDS);
+        threaded = true;
+        audio_thread = std::thread(&SPU::audioLoop, this);
+    } else {
+        ring->drain();
+        ring->stop();
+        audio_thread.join();
+        threaded = false;
+        ring.reset();
+    }
+}
+
+void SPU::connectAudio(const AudioSink& new_sink) {
+    // The mixer is idle after sync() until the next ring push
+    sync();
+    sink = new_sink;
+}
+
+void SPU::sync() {
+    if (bus) {
+        catchUp();
+    }
+    flushFifo();
+    if (threaded) {
+        ring->drain();
+    }
+}
+
+void SPU::catchUp() {
+    const uint64_t elapsed = (bus->scheduler.timestamp() - last_sync) / CYCLES_PER_SAMPLE;
+    if (elapsed == 0) return;
+
+    // Uploads queued so far happened before these samples
+    flushFifo();
+
+    last_sync += elapsed * CYCLES_PER_SAMPLE;
+    submitRun(static_cast<uint32_t>(elapsed));
+}
+
+void SPU::scheduleBatch() {
+    bus->scheduler.scheduleAt(Event::SPU, last_sync + BATCH_SAMPLES * CYCLES_PER_SAMPLE);
+}
+
+void SPU::onBatch(void* ctx, uint64_t now) {
+    (void)now;
+    SPU* spu = static_cast<SPU*>(ctx);
+    spu->catchUp();
+    spu->scheduleBatch();
+}
+
+void SPU::flushFifo() {
+    if (fifo.empty()) return;
+    submitRAM(fifo_addr, fifo.data(), static_cast<uint32_t>(fifo.size()));
+    fifo.clear();
+}
+
+void SPU::submitRun(uint32_t samples) {
+    if (threaded) {
+        ring->push(RING_RUN, &samples, 1);
+    } else {
+        render(samples);
+    }
+}
+
+void SPU::submitWrite(uint32_t offset, uint16_t value) {
+    if (threaded) {
+        const uint32_t word = (offset << 16) | value;
+        ring->push(RING_WRITE, &word, 1);
+    } else {
+        applyWrite(offset, value);
+    }
+}
+
+void SPU::submitRAM(uint32_t address, const void* data, uint32_t count) {
+    if (!threaded) {
+        writeRAM(address, data, count);
+        return;
+    }
+
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    while (count > 0) {
+        const uint32_t run = std::min(count, RAM_CHUNK_HALFWORDS);
+        staging.assign(2 + (run + 1) / 2, 0);
+        staging[0] = address;
+        staging[1] = run;
+        std::memcpy(&staging[2], src, run * 2);
+        ring->push(RING_RAM, staging.data(), static_cast<uint32_t>(staging.size()));
+
+        address = (address + run * 2) & RAM_MASK;
+        src += run * 2;
+        count -= run;
+    }
+}
+
+void SPU::audioLoop() {
+    while (ring->wait()) {
+        CommandRing::Entry entry = ring->front();
+        switch (entry.tag) {
+            case RING_RUN:   render(entry.words[0]); break;
+            case RING_WRITE: applyWrite(entry.words[0] >> 16, entry.words[0] & 0xFFFF); break;
+            case RING_RAM:   writeRAM(entry.words[0], entry.words + 2, entry.words[1]); break;
+            default: break;
+        }
+        ring->pop();
+    }
+}
+
+// --- Mixer side ---
+
+void SPU::applyWrite(uint32_t offset, uint16_t value) {
+    if (offset < 0x180) {
+        Voice& voice = voices[offset >> 4];
+        switch (offset & 0xE) {
+            case 0x0: voice.vol_l.set(value); break;
+            case 0x2: voice.vol_r.set(value); break;
+            case 0x4: voice.pitch = value; break;
+            case 0x6: voice.start = (value * 8u) & RAM_MASK; break;
+            case 0x8: voice.adsr_lo = value; updateEnvelope(voice); break;
+            case 0xA: voice.adsr_hi = value; updateEnvelope(voice); break;
+            case 0xC: voice.level = static_cast<int16_t>(value); break;
+            case 0xE:
+                // A repeat address set by software wins over loop start flags
+                voice.repeat = (value * 8u) & RAM_MASK;
+                voice.ignore_repeat = true;
+                break;
+        }
+        return;
+    }
+
+    if (offset >= 0x1C0 && offset < 0x200) {
+        reverb_regs[(offset - 0x1C0) >> 1] = value;
+        return;
+    }
+
+    switch (offset) {
+        case 0x180: main_l.set(value); break;
+        case 0x182: main_r.set(value); break;
+        case 0x184: reverb_vol_l = static_cast<int16_t>(value); break;
+        case 0x186: reverb_vol_r = static_cast<int16_t>(value); break;
+        case 0x188: case 0x18A:
+        case 0x18C: case 0x18E: {
+            uint32_t mask = 0;
+            setHalf(mask, offset, value);
+            for (int v = 0; v < VOICE_COUNT; v++) {
+                if (!(mask & (1u << v))) continue;
+                if (offset < 0x18C) keyOn(v);
+                else keyOff(v);
+            }
+            break;
+        }
+        case 0x190: case 0x192: setHalf(pmon, offset, value); break;
+        case 0x194: case 0x196: setHalf(non, offset, value); break;
+        case 0x198: case 0x19A: setHalf(eon, offset, value); break;
+        case 0x1A2:
+            reverb_base = (value * 8u) & RAM_MASK;
+            reverb_current = reverb_base;
+            break;
+        case 0x1A4: irq_addr = (value * 8u) & RAM_MASK; break;
+        case 0x1AA:
+            control = value;
+            if (!(value & CNT_IRQ)) mixer_irq_epoch++;
+            break;
+        default:
+            break;
+    }
+}
+
+void SPU::writeRAM(uint32_t address, const void* data, uint32_t count) {
+    address &= RAM_MASK;
+    checkIRQ(address, count * 2);
+
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    uint32_t index = address >> 1;
+    while (count > 0) {
+        const uint32_t run = std::min(count, RAM_SIZE / 2 - index);
+        std::memcpy(&ram[index], src, run * 2);
+        src += run * 2;
+        count -= run;
+        index = 0;
+    }
+}
+
+void SPU::checkIRQ(uint32_t address, uint32_t size) {
+    if (!(control & CNT_IRQ)) return;
+    if (((irq_addr - address) & RAM_MASK) >= size) return;
+
+    if (irq_raised.load(std::memory_order_relaxed) != mixer_irq_epoch + 1) {
+        irq_raised.store(mixer_irq_epoch + 1, std::memory_order_relaxed);
+        bus->interrupts.request(IRQ::SPU);
+    }
+}
+
+void SPU::keyOn(int index) {
+    Voice& voice = voices[index];
+    voice.address = voice.start;
+    voice.counter = 0;
+    voice.ignore_repeat = false;
+    voice.phase = Phase::Attack;
+    voice.level = 0;
+    updateEnvelope(voice);
+
+    voice.window.fill(0);
+    voice.old = voice.older = 0;
+    decodeBlock(voice, &voice.window[3]);
+
+    endx.fetch_and(~(1u << index), std::memory_order_relaxed);
+}
+
+void SPU::keyOff(int index) {
+    Voice& voice = voices[index];
+    if (voice.phase == Phase::Off || voice.phase == Phase::Release) return;
+
+    voice.phase = Phase::Release;
+    updateEnvelope(voice);
+}
+
+void SPU::updateEnvelope(Voice& voice) {
+    const uint16_t lo = voice.adsr_lo;
+    const uint16_t hi = voice.adsr_hi;
+
+    switch (voice.phase) {
+        case Phase::Attack:  voice.adsr.reset((lo >> 8) & 0x7F, false, (lo & 0x8000) != 0); break;
+        case Phase::Decay:   voice.adsr.reset(((lo >> 4) & 0xF) << 2, true, true); break;
+        case Phase::Sustain: voice.adsr.reset((hi >> 6) & 0x7F, (hi & 0x4000) != 0, (hi & 0x8000) != 0); break;
+        case Phase::Release: voice.adsr.reset((hi & 0x1F) << 2, true, (hi & 0x20) != 0); break;
+        case Phase::Off:     voice.adsr.reset(0, false, false); break;
+    }
+}
+
+void SPU::tickADSR(Voice& voice) {
+    voice.level = voice.adsr.tick(voice.level);
+
+    Phase next = voice.phase;
+    switch (voice.phase) {
+        case Phase::Attack:
+            if (voice.level >= 0x7FFF) next = Phase::Decay;
+            break;
+        case Phase::Decay:
+            if (voice.level <= sustainLevel(voice.adsr_lo)) next = Phase::Sustain;
+            break;
+        case Phase::Release:
+            if (voice.level <= 0) next = Phase::Off;
+            break;
+        default:
+            break;
+    }
+
+    if (next != voice.phase) {
+        voice.phase = next;
+        updateEnvelope(voice);
+    }
+}
+
+void SPU::decodeBlock(Voice& voice, int16_t* out) {
+    const uint32_t address = voice.address & RAM_MASK;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(ram.data());
+
+    // Only a block starting in the last 8 bytes wraps around sound RAM
+    alignas(16) uint8_t wrapped[DSP::BLOCK_BYTES];
+    const uint8_t* block = bytes + address;
+    if (address > RAM_SIZE - DSP::BLOCK_BYTES) {
+        for (uint32_t i = 0; i < DSP::BLOCK_BYTES; i++) {
+            wrapped[i] = bytes[(address + i) & RAM_MASK];
+        }
+        block = wrapped;
+    }
+
+    checkIRQ(address, DSP::BLOCK_BYTES);
+
+    if ((block[1] & BLOCK_LOOP_START) && !voice.ignore_repeat) {
+        voice.repeat = address;
+    }
+
+    DSP::decodeBlock(block, out, voice.old, voice.older);
+}
+
+void SPU::endOfBlock(int index) {
+    Voice& voice = voices[index];
+    const uint8_t flags = reinterpret_cast<const uint8_t*>(ram.data())[(voice.address + 1) & RAM_MASK];
+
+    if (!(flags & BLOCK_LOOP_END)) {
+        voice.address = (voice.address + DSP::BLOCK_BYTES) & RAM_MASK;
+        return;
+    }
+
+    endx.fetch_or(1u << index, std::memory_order_relaxed);
+    voice.address = voice.repeat;
+
+    // Loop end without repeat silences the voice
+    if (!(flags & BLOCK_LOOP_REPEAT)) {
+        voice.phase = Phase::Off;
+        voice.level = 0;
+        updateEnvelope(voice);
+    }
+}
+
+void SPU::stepNoise(int count) {
+    const int32_t step = ((control >> 8) & 3) + 4;
+    const int32_t period = 0x20000 >> ((control >> 10) & 0xF);
+
+    for (int k = 0; k < count; k++) {
+        noise[k] = static_cast<int16_t>(noise_level);
+
+        noise_timer -= step;
+        if (noise_timer < 0) {
+            const uint16_t parity = ((noise_level >> 15) ^ (noise_level >> 12) ^ (noise_level >> 11) ^ (noise_level >> 10) ^ 1) & 1;
+            noise_level = static_cast<uint16_t>((noise_level << 1) | parity);
+            noise_timer += period;
+            if (noise_timer < 0) noise_timer += period;
+        }
+    }
+}
+
+void SPU::render(uint32_t samples) {
+    while (samples > 0) {
+        const int count = static_cast<int>(std::min<uint32_t>(samples, CHUNK));
+        mixChunk(count);
+        samples -= count;
+    }
+}
+
+void SPU::renderVoice(int index, int count) {
+    Voice& voice = voices[index];
+    int16_t* out = voice_out[index].data();
+
+    if (voice.phase == Phase::Off) {
+        std::fill_n(out, count, 0);
+        return;
+    }
+
+    // Pitch modulation reads the previous voice's output, which is already mixed
+    const bool modulated = index > 0 && ((pmon >> index) & 1);
+    const int16_t* prev = index > 0 ? voice_out[index - 1].data() : nullptr;
+
+    // Walk the pitch counter and envelope sample by sample, decoding blocks as
+    // they are reached; the interpolation itself then runs over the whole chunk.
+    std::copy(voice.window.begin(), voice.window.end(), pcm.begin());
+    int block = 3;
+
+    for (int k = 0; k < count; k++) {
+        pos[k] = block + static_cast<int32_t>(voice.counter >> 12) - 3;
+        frac[k] = (voice.counter >> 4) & 0xFF;
+        env[k] = voice.level;
+
+        if (voice.phase != Phase::Off) {
+            tickADSR(voice);
+        }
+
+        uint32_t step = voice.pitch;
+        if (modulated) {
+            const int32_t factor = prev[k] + 0x8000;
+            step = static_cast<uint16_t>((static_cast<int16_t>(step) * factor) >> 15);
+        }
+        voice.counter += std::min<uint32_t>(step, 0x3FFF);
+
+        if ((voice.counter >> 12) >= DSP::SAMPLES_PER_BLOCK) {
+            voice.counter -= DSP::SAMPLES_PER_BLOCK << 12;
+            endOfBlock(index);
+            block += DSP::SAMPLES_PER_BLOCK;
+            decodeBlock(voice, &pcm[block]);
+        }
+    }
+
+    std::copy_n(&pcm[block - 3], voice.window.size(), voice.window.begin());
+
+    if ((non >> index) & 1) {
+        DSP::scale(noise.data(), env.data(), out, count);
+    } else {
+        DSP::interpolate(pcm.data(), pos.data(), frac.data(), env.data(), out, count);
+    }
+
+    if (voice.vol_l.sweep || voice.vol_r.sweep) {
+        for (int k = 0; k < count; k++) {
+            vol_l[k] = voice.vol_l.tick();
+            vol_r[k] = voice.vol_r.tick();
+        }
+    } else {
+        std::fill_n(vol_l.begin(), count, voice.vol_l.level);
+        std::fill_n(vol_r.begin(), count, voice.vol_r.level);
+    }
+
+    DSP::accumulate(out, vol_l.data(), mix_l.data(), count);
+    DSP::accumulate(out, vol_r.data(), mix_r.data(), count);
+    if ((eon >> index) & 1) {
+        DSP::accumulate(out, vol_l.data(), rev_l.data(), count);
+        DSP::accumulate(out, vol_r.data(), rev_r.data(), count);
+    }
+}
+
+uint32_t SPU::reverbAddress(uint16_t reg, int32_t delta) const {
+    // Offsets are relative to the moving buffer position and wrap inside [mBASE, end of RAM)
+    const int64_t size = RAM_SIZE - reverb_base;
+    int64_t offset = (static_cast<int64_t>(reverb_current - reverb_base) + static_cast<int64_t>(reg) * 8 + delta) % size;
+    if (offset < 0) offset += size;
+    return (reverb_base + static_cast<uint32_t>(offset)) >> 1;
+}
+
+void SPU::reverb(int32_t in_l, int32_t in_r) {
+    const bool write = (control & CNT_REVERB) != 0;
+
+    auto vol = [this](int reg) { return static_cast<int32_t>(static_cast<int16_t>(reverb_regs[reg])); };
+    auto at = [this](int reg, int32_t delta = 0) {
+        return static_cast<int32_t>(static_cast<int16_t>(ram[reverbAddress(reverb_regs[reg], delta)]));
+    };
+    auto store = [this, write](int reg, int32_t value) {
+        if (write) ram[reverbAddress(reverb_regs[reg], 0)] = static_cast<uint16_t>(clamp16(value));
+    };
+
+    const int32_t lin = mul15(vol(vLIN), in_l);
+    const int32_t rin = mul15(vol(vRIN), in_r);
+
+    // Same side and cross-channel reflections (IIR)
+    auto reflect = [&](int dst, int src, int32_t input) {
+        const int32_t prev = at(dst, -2);
+        store(dst, mul15(clamp16(input + mul15(at(src), vol(vWALL)) - prev), vol(vIIR)) + prev);
+    };
+    reflect(mLSAME, dLSAME, lin);
+    reflect(mRSAME, dRSAME, rin);
+    reflect(mLDIFF, dRDIFF, lin);
+    reflect(mRDIFF, dLDIFF, rin);
+
+    // Early echo (comb filter)
+    int32_t lout = mul15(vol(vCOMB1), at(mLCOMB1)) + mul15(vol(vCOMB2), at(mLCOMB2)) +
+                   mul15(vol(vCOMB3), at(mLCOMB3)) + mul15(vol(vCOMB4), at(mLCOMB4));
+    int32_t rout = mul15(vol(vCOMB1), at(mRCOMB1)) + mul15(vol(vCOMB2), at(mRCOMB2)) +
+                   mul15(vol(vCOMB3), at(mRCOMB3)) + mul15(vol(vCOMB4), at(mRCOMB4));
+
+    // Late reverb: two all-pass stages
+    auto allPass = [&](int32_t x, int m, int d, int v) {
+        const int32_t delayed = at(m, -static_cast<int32_t>(reverb_regs[d]) * 8);
+        x = clamp16(x - mul15(vol(v), delayed));
+        store(m, x);
+        return clamp16(mul15(x, vol(v)) + delayed);
+    };
+    lout = allPass(allPass(clamp16(lout), mLAPF1, dAPF1, vAPF1), mLAPF2, dAPF2, vAPF2);
+    rout = allPass(allPass(clamp16(rout), mRAPF1, dAPF1, vAPF1), mRAPF2, dAPF2, vAPF2);
+
+    reverb_out_l = mul15(lout, reverb_vol_l);
+    reverb_out_r = mul15(rout, reverb_vol_r);
+
+    reverb_current += 2;
+    if (reverb_current >= RAM_SIZE) reverb_current = reverb_base;
+}
+
+void SPU::mixChunk(int count) {
+    std::fill_n(mix_l.begin(), count, 0);
+    std::fill_n(mix_r.begin(), count, 0);
+    std::fill_n(rev_l.begin(), count, 0);
+    std::fill_n(rev_r.begin(), count, 0);
+
+    stepNoise(count);
+
+    if (control & CNT_ENABLE) {
+        for (int v = 0; v < VOICE_COUNT; v++) {
+            renderVoice(v, count);
+        }
+    } else {
+        std::fill_n(voice_out[1].begin(), count, 0);
+        std::fill_n(voice_out[3].begin(), count, 0);
+    }
+
+    const bool unmuted = (control & CNT_UNMUTE) != 0;
+    const bool capture_irq = (control & CNT_IRQ) && irq_addr < 0x1000;
+
+    for (int k = 0; k < count; k++) {
+        // Capture buffers (CD input is silent until there is a drive to feed it)
+        const uint32_t slot = capture_index;
+        ram[CAPTURE_CD_L + slot] = 0;
+        ram[CAPTURE_CD_R + slot] = 0;
+        ram[CAPTURE_VOICE1 + slot] = static_cast<uint16_t>(voice_out[1][k]);
+        ram[CAPTURE_VOICE3 + slot] = static_cast<uint16_t>(voice_out[3][k]);
+        if (capture_irq && ((irq_addr & 0x3FF) >> 1) == slot) {
+            checkIRQ(irq_addr, 1);
+        }
+        capture_index = (capture_index + 1) & 0x1FF;
+
+        // Reverb runs at 22.05 kHz on the average of each input pair
+        const int32_t in_l = clamp16(rev_l[k]);
+        const int32_t in_r = clamp16(rev_r[k]);
+        if (reverb_odd) {
+            reverb((reverb_in_l + in_l) >> 1, (reverb_in_r + in_r) >> 1);
+        } else {
+            reverb_in_l = in_l;
+            reverb_in_r = in_r;
+        }
+        reverb_odd = !reverb_odd;
+
+        const int32_t left = clamp16(clamp16(mix_l[k]) + reverb_out_l);
+        const int32_t right = clamp16(clamp16(mix_r[k]) + reverb_out_r);
+        const int32_t master_l = main_l.tick();
+        const int32_t master_r = main_r.tick();
+
+        frames[k * 2] = unmuted ? static_cast<int16_t>(mul15(left, master_l)) : 0;
+        frames[k * 2 + 1] = unmuted ? static_cast<int16_t>(mul15(right, master_r)) : 0;
+    }
+
+    for (int v = 0; v < VOICE_COUNT; v++) {
+        adsr_levels[v].store(static_cast<uint16_t>(voices[v].level), std::memory_order_relaxed);
+    }
+    capture_half.store(capture_index >= 0x100, std::memory_order_relaxed);
+
+    if (sink.write) {
+        sink.write(sink.ctx, frames.data(), static_cast<uint32_t>(count));
+    }
+}
@@ -0,0 +1,78 @@
+/*
+    Description: Root Counters (Timers 0-2) Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+class Bus;
+
+// The counters are never ticked. Each one remembers the timestamp and value of its
+// last synchronisation and derives the current value from the scheduler clock on
+// access; target/overflow IRQs are scheduled as future events.
+class Timers {
+    public:
+        Timers(Bus* bus);
+        ~Timers();
+
+        void init();
+
+        // Register interface (offset relative to 0x1F801100)
+        uint32_t read32(uint32_t offset);
+        void write32(uint32_t offset, uint32_t data);
+
+        // read32 without clearing the mode register's "reached" flags
+        uint32_t peek32(uint32_t offset);
+
+        // Called by the GPU when the display mode changes the dot clock or line length
+        void setVideoClocks(uint32_t dot_divider, uint32_t gpu_cycles_per_line);
+
+    private:
+        static constexpr int TIMER_COUNT = 3;
+
+        // Mode register fields
+        static constexpr uint32_t MODE_SYNC_ENABLE   = 1u << 0;
+        static constexpr uint32_t MODE_RESET_TARGET  = 1u << 3;
+        static constexpr uint32_t MODE_IRQ_TARGET    = 1u << 4;
+        static constexpr uint32_t MODE_IRQ_OVERFLOW  = 1u << 5;
+        static constexpr uint32_t MODE_IRQ_REPEAT    = 1u << 6;
+        static constexpr uint32_t MODE_IRQ_TOGGLE    = 1u << 7;
+        static constexpr uint32_t MODE_IRQ_LINE      = 1u << 10;  // 0 = IRQ asserted
+        static constexpr uint32_t MODE_HIT_TARGET    = 1u << 11;
+        static constexpr uint32_t MODE_HIT_OVERFLOW  = 1u << 12;
+
+        struct Timer {
+            uint32_t value;
+            uint32_t mode;
+            uint32_t target;
+
+            uint64_t last_sync;     // Scheduler timestamp of the last sync
+            uint64_t frac;          // Sub-tick remainder, in units of 1/den ticks
+            uint32_t num, den;      // Counter ticks per CPU cycle, as a fraction
+            bool irq_done;          // One-shot mode: IRQ already delivered
+        };
+
+        // Bring the counter up to the current timestamp. Returns the MODE_HIT_* bits crossed.
+        uint32_t sync(int n);
+        void updateClockSource(int n);
+        void reschedule(int n);
+        bool isPaused(int n) const;
+
+        void fire(int n);
+
+        template <int N>
+        static void onEvent(void* ctx, uint64_t now) {
+            (void)now;
+            static_cast<Timers*>(ctx)->fire(N);
+        }
+
+        Bus* bus = nullptr;
+        std::array<Timer, TIMER_COUNT> timers;
+
+        uint32_t dot_divider = 10;            // 256-pixel mode
+        uint32_t gpu_cycles_per_line = 3413;  // NTSC
+};
@@ -0,0 +1,281 @@
+/*
+    Description: Root Counters (Timers 0-2) Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "timers.hpp"
+#include "bus.hpp"
+#include <algorithm>
+
+namespace {
+    constexpr Event timerEvent(int n) {
+        return static_cast<Event>(static_cast<int>(Event::Timer0) + n);
+    }
+
+    constexpr IRQ timerIRQ(int n) {
+        return static_cast<IRQ>(static_cast<uint32_t>(IRQ::Timer0) + n);
+    }
+
+    // GPU clock is 11/7 of the CPU clock
+    constexpr uint32_t GPU_CLOCK_NUM = 11;
+    constexpr uint32_t GPU_CLOCK_DEN = 7;
+
+    // Ticks from `v` until a counter wrapping at `period` next shows `goal`
+    constexpr uint64_t distance(uint64_t v, uint64_t goal, uint64_t period) {
+        return goal > v ? goal - v : period - v + goal;
+    }
+}
+
+Timers::Timers(Bus* bus) : bus(bus) {
+    init();
+}
+
+Timers::~Timers() = default;
+
+void Timers::init() {
+    uint64_t now = bus ? bus->scheduler.timestamp() : 0;
+
+    for (int n = 0; n < TIMER_COUNT; n++) {
+        Timer& t = timers[n];
+        t.value = 0;
+        t.mode = MODE_IRQ_LINE;
+        t.target = 0;
+        t.last_sync = now;
+        t.frac = 0;
+        t.irq_done = false;
+        updateClockSource(n);
+    }
+
+    if (!bus) return;
+
+    bus->scheduler.registerEvent(timerEvent(0), &Timers::onEvent<0>, this);
+    bus->scheduler.registerEvent(timerEvent(1), &Timers::onEvent<1>, this);
+    bus->scheduler.registerEvent(timerEvent(2), &Timers::onEvent<2>, this);
+}
+
+uint32_t Timers::read32(uint32_t offset) {
+    uint32_t value = peek32(offset);
+
+    int n = (offset >> 4) & 0x3;
+    if (n < TIMER_COUNT && (offset & 0xC) == 0x4) {
+        // The "reached" flags clear on read
+        timers[n].mode &= ~(MODE_HIT_TARGET | MODE_HIT_OVERFLOW);
+    }
+    return value;
+}
+
+uint32_t Timers::peek32(uint32_t offset) {
+    int n = (offset >> 4) & 0x3;
+    if (n >= TIMER_COUNT) return 0;
+
+    Timer& t = timers[n];
+    switch (offset & 0xC) {
+        case 0x0:
+            sync(n);
+            return t.value;
+        case 0x4:
+            sync(n);
+            return t.mode;
+        case 0x8:
+            return t.target;
+        default:
+            return 0;
+    }
+}
+
+void Timers::write32(uint32_t offset, uint32_t data) {
+    int n = (offset >> 4) & 0x3;
+    if (n >= TIMER_COUNT) return;
+
+    Timer& t = timers[n];
+    switch (offset & 0xC) {
+        case 0x0:
+            sync(n);
+            t.value = data & 0xFFFF;
+            break;
+        case 0x4:
+            // Writing the mode resets the counter and re-arms the IRQ
+            sync(n);
+            t.mode = (t.mode & (MODE_HIT_TARGET | MODE_HIT_OVERFLOW)) | (data & 0x3FF) | MODE_IRQ_LINE;
+            t.value = 0;
+            t.frac = 0;
+            t.irq_done = false;
+            updateClockSource(n);
+            break;
+        case 0x8:
+            sync(n);
+            t.target = data & 0xFFFF;
+            break;
+        default:
+            return;
+    }
+
+    reschedule(n);
+}
+
+void Timers::setVideoClocks(uint32_t dot_div, uint32_t cycles_per_line) {
+    if (dot_div == dot_divider && cycles_per_line == gpu_cycles_per_line) return;
+
+    for (int n = 0; n < 2; n++) sync(n);
+
+    dot_divider = dot_div;
+    gpu_cycles_per_line = cycles_per_line;
+
+    for (int n = 0; n < 2; n++) {
+        timers[n].frac = 0;
+        updateClockSource(n);
+        reschedule(n);
+    }
+}
+
+void Timers::updateClockSource(int n) {
+    Timer& t = timers[n];
+    uint32_t source = (t.mode >> 8) & 3;
+
+    t.num = 1;
+    t.den = 1;
+
+    switch (n) {
+        case 0:
+            if (source & 1) {
+                t.num = GPU_CLOCK_NUM;
+                t.den = GPU_CLOCK_DEN * dot_divider;
+            }
+            break;
+        case 1:
+            if (source & 1) {
+                t.num = GPU_CLOCK_NUM;
+                t.den = GPU_CLOCK_DEN * gpu_cycles_per_line;
+            }
+            break;
+        case 2:
+            if (source & 2) t.den = 8;
+            break;
+    }
+}
+
+bool Timers::isPaused(int n) const {
+    const Timer& t = timers[n];
+    if (!(t.mode & MODE_SYNC_ENABLE)) return false;
+
+    // Timer 2 sync modes 0 and 3 halt the counter. Timers 0/1 gate on h/vblank,
+    // which free-runs until the GPU starts reporting blanking periods.
+    uint32_t sync_mode = (t.mode >> 1) & 3;
+    return n == 2 && (sync_mode == 0 || sync_mode == 3);
+}
+
+uint32_t Timers::sync(int n) {
+    Timer& t = timers[n];
+    const uint64_t now = bus->scheduler.timestamp();
+    const uint64_t elapsed = now - t.last_sync;
+    t.last_sync = now;
+
+    if (elapsed == 0 || isPaused(n)) return 0;
+
+    uint64_t scaled = elapsed * t.num + t.frac;
+    uint64_t ticks = scaled / t.den;
+    t.frac = scaled % t.den;
+
+    if (ticks == 0) return 0;
+
+    uint32_t hits = 0;
+    const uint64_t v = t.value;
+    const uint64_t target = t.target;
+
+    if (t.mode & MODE_RESET_TARGET) {
+        const uint64_t period = target + 1;
+
+        if (v > target) {
+            // A value already past the target runs up to 0xFFFF and wraps first
+            const uint64_t to_wrap = 0x10000 - v;
+            if (v < 0xFFFF && ticks >= 0xFFFF - v) hits |= MODE_HIT_OVERFLOW;
+
+            if (ticks < to_wrap) {
+                t.value = static_cast<uint32_t>(v + ticks);
+            } else {
+                ticks -= to_wrap;
+                if (ticks >= target) hits |= MODE_HIT_TARGET;
+                t.value = static_cast<uint32_t>(ticks % period);
+            }
+        } else {
+            if (ticks >= distance(v, target, period)) {
+                hits |= MODE_HIT_TARGET;
+                if (target == 0xFFFF) hits |= MODE_HIT_OVERFLOW;
+            }
+            t.value = static_cast<uint32_t>((v + ticks) % period);
+        }
+    } else {
+        if (ticks >= distance(v, target, 0x10000)) hits |= MODE_HIT_TARGET;
+        if (ticks >= distance(v, 0xFFFF, 0x10000)) hits |= MODE_HIT_OVERFLOW;
+        t.value = static_cast<uint32_t>((v + ticks) & 0xFFFF);
+    }
+
+    t.mode |= hits;
+    return hits;
+}
+
+void Timers::reschedule(int n) {
+    Timer& t = timers[n];
+    const Event event = timerEvent(n);
+
+    const bool want_target = (t.mode & MODE_IRQ_TARGET) != 0;
+    const bool want_overflow = (t.mode & MODE_IRQ_OVERFLOW) != 0;
+    const bool one_shot_spent = !(t.mode & MODE_IRQ_REPEAT) && t.irq_done;
+
+    if ((!want_target && !want_overflow) || one_shot_spent || isPaused(n)) {
+        bus->scheduler.cancel(event);
+        return;
+    }
+
+    // Ticks until the next target / overflow hit, strictly in the future
+    const uint64_t v = t.value;
+    const uint64_t target = t.target;
+    uint64_t to_target, to_overflow = UINT64_MAX;
+
+    if (!(t.mode & MODE_RESET_TARGET)) {
+        to_target = distance(v, target, 0x10000);
+        to_overflow = distance(v, 0xFFFF, 0x10000);
+    } else if (v > target) {
+        to_target = 0x10000 - v + target;
+        if (v < 0xFFFF) to_overflow = 0xFFFF - v;
+    } else {
+        to_target = distance(v, target, target + 1);
+        if (target == 0xFFFF) to_overflow = to_target;
+    }
+
+    uint64_t ticks = UINT64_MAX;
+    if (want_target) ticks = std::min(ticks, to_target);
+    if (want_overflow) ticks = std::min(ticks, to_overflow);
+
+    if (ticks == UINT64_MAX) {
+        bus->scheduler.cancel(event);
+        return;
+    }
+
+    // Smallest cycle count c with (c * num + frac) / den >= ticks
+    uint64_t needed = ticks * t.den;
+    uint64_t cycles = needed > t.frac ? (needed - t.frac + t.num - 1) / t.num : 0;
+    bus->scheduler.scheduleAt(event, t.last_sync + std::max<uint64_t>(cycles, 1));
+}
+
+void Timers::fire(int n) {
+    Timer& t = timers[n];
+    uint32_t hits = sync(n);
+
+    bool irq = ((hits & MODE_HIT_TARGET) && (t.mode & MODE_IRQ_TARGET)) ||
+               ((hits & MODE_HIT_OVERFLOW) && (t.mode & MODE_IRQ_OVERFLOW));
+
+    if (irq && !(!(t.mode & MODE_IRQ_REPEAT) && t.irq_done)) {
+        if (t.mode & MODE_IRQ_TOGGLE) {
+            t.mode ^= MODE_IRQ_LINE;
+            if (!(t.mode & MODE_IRQ_LINE)) bus->interrupts.request(timerIRQ(n));
+        } else {
+            // Pulse mode: the line only drops for a few cycles, so it reads back as idle
+            bus->interrupts.request(timerIRQ(n));
+        }
+        t.irq_done = true;
+    }
+
+    reschedule(n);
+}
@@ -0,0 +1,75 @@
+/*
+    Description: Asynchronous Logging Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Call sites record a pointer to a static format (level, tag, text) and up to
+// MAX_ARGS integer arguments into a lock-free ring owned by the calling thread.
+// A background thread merges the rings in order, formats the text and writes it
+// to stderr, so logging from the emulation thread costs a few stores. When a
+// ring is full, records are dropped (and counted) rather than stalling the
+// producer.
+//
+// Placeholders in the text: {} prints the next argument in decimal, {x} in hex.
+//
+// Levels below LOG_LEVEL are compiled out. The default is Info, or Debug when
+// DEBUG is defined (`make debug`); pass -DLOG_LEVEL=0 to keep Trace records.
+
+enum class LogLevel : uint8_t {
+    Trace,
+    Debug,
+    Info,
+    Warn,
+    Error
+};
+
+#ifndef LOG_LEVEL
+#ifdef DEBUG
+#define LOG_LEVEL 1
+#else
+#define LOG_LEVEL 2
+#endif
+#endif
+
+struct LogFormat {
+    LogLevel level;
+    const char* tag;
+    const char* text;
+};
+
+namespace Log {
+    constexpr size_t MAX_ARGS = 6;
+
+    void write(const LogFormat* format, const uint64_t* args, uint32_t count);
+
+    template <typename... Args>
+    inline void record(const LogFormat* format, Args... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "Too many log arguments");
+        // Sign-extended, so {} prints negative values as such
+        const uint64_t values[sizeof...(Args) + 1] = {static_cast<uint64_t>(static_cast<int64_t>(args))...};
+        write(format, values, sizeof...(Args));
+    }
+
+    // Format and write everything recorded so far before returning, e.g. ahead of an abort
+    void flush();
+}
+
+#define LOG_AT(level, tag, text, ...)                                           \
+    do {                                                                        \
+        if constexpr (static_cast<int>(level) >= LOG_LEVEL) {                   \
+            static constexpr LogFormat log_format_{level, tag, text};           \
+            Log::record(&log_format_, ##__VA_ARGS__);                           \
+        }                                                                       \
+    } while (0)
+
+#define LOG_TRACE(tag, text, ...) LOG_AT(LogLevel::Trace, tag, text, ##__VA_ARGS__)
+#define LOG_DEBUG(tag, text, ...) LOG_AT(LogLevel::Debug, tag, text, ##__VA_ARGS__)
+#define LOG_INFO(tag, text, ...)  LOG_AT(LogLevel::Info, tag, text, ##__VA_ARGS__)
+#define LOG_WARN(tag, text, ...)  LOG_AT(LogLevel::Warn, tag, text, ##__VA_ARGS__)
+#define LOG_ERROR(tag, text, ...) LOG_AT(LogLevel::Error, tag, text, ##__VA_ARGS__)
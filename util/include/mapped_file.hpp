@@ -0,0 +1,39 @@
+/*
+    Description: Memory-Mapped File Header File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only mapping of a whole file. Pages are faulted in by the kernel on first
+// touch; willNeed() starts that I/O ahead of time so a slow (network) mount is
+// read in the background instead of stalling the thread that touches the page.
+class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const { return base != nullptr; }
+        const uint8_t* data() const { return base; }
+        size_t size() const { return length; }
+
+        // Asynchronous read-ahead hint for [offset, offset + count)
+        void willNeed(size_t offset, size_t count) const;
+
+    private:
+        const uint8_t* base = nullptr;
+        size_t length = 0;
+};
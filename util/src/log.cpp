@@ -0,0 +1,179 @@
+/*
+    Description: Asynchronous Logging Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "log.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr size_t RING_RECORDS = 4096;   // Power of two
+    constexpr auto FLUSH_INTERVAL = std::chrono::milliseconds(10);
+
+    struct Record {
+        const LogFormat* format;
+        uint64_t sequence;                  // Global order across threads
+        uint32_t count;
+        uint64_t args[Log::MAX_ARGS];
+    };
+
+    // Written by its owning thread only; read under Logger::drain_mutex
+    struct Ring {
+        std::array<Record, RING_RECORDS> records;
+        alignas(64) std::atomic<uint64_t> write_pos{0};
+        alignas(64) std::atomic<uint64_t> read_pos{0};
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    class Logger {
+        public:
+            static Logger& instance() {
+                static Logger logger;
+                return logger;
+            }
+
+            ~Logger() {
+                {
+                    std::lock_guard<std::mutex> lock(wake_mutex);
+                    quit = true;
+                }
+                wake.notify_one();
+                worker.join();
+                drain();
+            }
+
+            Ring* registerThread() {
+                std::lock_guard<std::mutex> lock(rings_mutex);
+                rings.push_back(std::make_unique<Ring>());
+                return rings.back().get();
+            }
+
+            uint64_t nextSequence() { return sequence.fetch_add(1, std::memory_order_relaxed); }
+
+            void drain();
+
+        private:
+            Logger() : worker(&Logger::run, this) {}
+
+            void run() {
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                while (!quit) {
+                    wake.wait_for(lock, FLUSH_INTERVAL);
+                    lock.unlock();
+                    drain();
+                    lock.lock();
+                }
+            }
+
+            void format(const Record& record);
+
+            std::mutex rings_mutex;
+            std::vector<std::unique_ptr<Ring>> rings;
+            std::atomic<uint64_t> sequence{0};
+
+            std::mutex drain_mutex;
+            std::vector<Record> batch;
+            std::string text;
+
+            std::mutex wake_mutex;
+            std::condition_variable wake;
+            bool quit = false;
+            std::thread worker;
+    };
+
+    void Logger::drain() {
+        std::lock_guard<std::mutex> drain_lock(drain_mutex);
+
+        std::vector<Ring*> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex);
+            for (const auto& ring : rings) snapshot.push_back(ring.get());
+        }
+
+        batch.clear();
+        uint64_t dropped = 0;
+        for (Ring* ring : snapshot) {
+            const uint64_t end = ring->write_pos.load(std::memory_order_acquire);
+            uint64_t pos = ring->read_pos.load(std::memory_order_relaxed);
+            for (; pos != end; pos++) batch.push_back(ring->records[pos & (RING_RECORDS - 1)]);
+            ring->read_pos.store(pos, std::memory_order_release);
+            dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+        }
+        if (batch.empty() && dropped == 0) return;
+
+        std::sort(batch.begin(), batch.end(),
+                  [](const Record& a, const Record& b) { return a.sequence < b.sequence; });
+
+        text.clear();
+        for (const Record& record : batch) format(record);
+        if (dropped) text += "[Log] " + std::to_string(dropped) + " records dropped\n";
+
+        std::fwrite(text.data(), 1, text.size(), stderr);
+        std::fflush(stderr);
+    }
+
+    void Logger::format(const Record& record) {
+        static const char HEX[] = "0123456789abcdef";
+
+        text += '[';
+        text += record.format->tag;
+        text += "] ";
+
+        uint32_t arg = 0;
+        for (const char* p = record.format->text; *p; p++) {
+            const bool dec = p[0] == '{' && p[1] == '}';
+            const bool hex = p[0] == '{' && p[1] == 'x' && p[2] == '}';
+            if ((!dec && !hex) || arg >= record.count) {
+                text += *p;
+                continue;
+            }
+
+            const uint64_t value = record.args[arg++];
+            if (dec) {
+                text += std::to_string(static_cast<int64_t>(value));
+                p += 1;
+            } else {
+                // Values recorded from 32-bit types print as 32 bits
+                const uint64_t shown = (value >> 32) == 0xFFFFFFFF ? value & 0xFFFFFFFF : value;
+                int digits = 1;
+                while (digits < 16 && (shown >> (digits * 4)) != 0) digits++;
+                while (digits > 0) text += HEX[(shown >> (--digits * 4)) & 0xF];
+                p += 2;
+            }
+        }
+        text += '\n';
+    }
+}
+
+void Log::write(const LogFormat* format, const uint64_t* args, uint32_t count) {
+    Logger& logger = Logger::instance();
+    thread_local Ring* ring = logger.registerThread();
+
+    const uint64_t pos = ring->write_pos.load(std::memory_order_relaxed);
+    if (pos - ring->read_pos.load(std::memory_order_acquire) >= RING_RECORDS) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Record& record = ring->records[pos & (RING_RECORDS - 1)];
+    record.format = format;
+    record.sequence = logger.nextSequence();
+    record.count = count;
+    std::copy(args, args + count, record.args);
+    ring->write_pos.store(pos + 1, std::memory_order_release);
+}
+
+void Log::flush() {
+    Logger::instance().drain();
+}
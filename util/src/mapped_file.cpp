@@ -0,0 +1,69 @@
+/*
+    Description: Memory-Mapped File Implementation File
+    Author: LN697
+    Date: 19 October 2026
+*/
+
+#include "mapped_file.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <utility>
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : base(std::exchange(other.base, nullptr)), length(std::exchange(other.length, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        base = std::exchange(other.base, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping keeps its own reference to the file
+    void* mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) return false;
+
+    base = static_cast<const uint8_t*>(mapping);
+    length = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (base) {
+        munmap(const_cast<uint8_t*>(base), length);
+    }
+    base = nullptr;
+    length = 0;
+}
+
+void MappedFile::willNeed(size_t offset, size_t count) const {
+    if (!base || offset >= length) return;
+
+    // madvise wants a page-aligned start
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t start = offset & ~(page - 1);
+    const size_t end = std::min(offset + count, length);
+    madvise(const_cast<uint8_t*>(base) + start, end - start, MADV_WILLNEED);
+}